@@ -0,0 +1,397 @@
+#include <Ultralight/Ultralight.h>
+#include <AppCore/AppCore.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace ultralight;
+
+///
+///  Headless CPU rendering benchmark.
+///
+///  Renders a fixed corpus of pages (static menu, CSS-animated HUD, 1,000-row table, text-heavy
+///  page) at several resolutions through the same path UltralightUE uses for CPU views:
+///  BitmapSurface + a 180-degree flip copy into a staging buffer (see UULUERenderTarget).
+///
+///  No GPU or display is needed. Results are written as JSON so CI can diff them between runs.
+///
+///  All cases share one process, and peak RSS is the process high-water mark. Each case therefore
+///  reports how far it raised that mark (peak_rss_growth_kb), not its own peak. A case that stays
+///  under an earlier case's peak reports 0. The top-level peak_rss_kb is the peak of the whole run.
+///
+///  Usage:
+///    BenchmarkCPU [--frames N] [--warmup N] [--unpaced] [--out results.json]
+///
+
+typedef std::chrono::steady_clock Clock;
+
+static double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+///
+/// Peak resident set size of this process, in kilobytes.
+///
+static long PeakRSSKilobytes() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  return static_cast<long>(usage.ru_maxrss / 1024); // bytes on macOS
+#else
+  return static_cast<long>(usage.ru_maxrss); // kilobytes on Linux
+#endif
+#endif
+}
+
+///
+/// Summary of one series of per-frame samples.
+///
+struct Series {
+  std::vector<double> samples;
+
+  void Add(double value) { samples.push_back(value); }
+
+  double Mean() const {
+    if (samples.empty())
+      return 0.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i)
+      sum += samples[i];
+    return sum / samples.size();
+  }
+
+  double Percentile(double p) const {
+    if (samples.empty())
+      return 0.0;
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+  }
+
+  double Max() const {
+    return samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+  }
+
+  std::string ToJson() const {
+    std::ostringstream out;
+    out << "{\"mean\": " << Mean() << ", \"p50\": " << Percentile(0.5)
+        << ", \"p95\": " << Percentile(0.95) << ", \"max\": " << Max() << "}";
+    return out.str();
+  }
+};
+
+struct PageSpec {
+  const char* name;
+  const char* url;   // loaded with LoadURL when set
+  std::string html;  // otherwise loaded with LoadHTML
+};
+
+struct Resolution {
+  uint32_t width;
+  uint32_t height;
+};
+
+struct CaseResult {
+  std::string page;
+  Resolution resolution;
+  bool loaded;
+  double load_ms;
+  Series frame_ms;
+  Series update_ms;
+  Series render_ms;
+  Series copy_ms;
+  Series dirty_pixels;
+  long peak_rss_growth_kb;
+};
+
+struct Options {
+  int frames = 240;
+  int warmup = 30;
+  bool paced = true;
+  std::string out_path;
+};
+
+///
+/// A 1,000-row table is too large to keep as a canned file, so it is generated deterministically.
+///
+static std::string BuildTablePage() {
+  std::ostringstream html;
+  html << "<html><head><style type=\"text/css\">"
+          "body { margin: 0; font-family: 'Segoe UI', 'Roboto', 'Arial', sans-serif; font-size: 13px;"
+          " color: #ddd; background: #202225; }"
+          "table { border-collapse: collapse; width: 100%; }"
+          "th { position: sticky; top: 0; background: #2f3136; text-align: left; padding: 6px; }"
+          "td { padding: 4px 6px; border-bottom: 1px solid #34373c; }"
+          "tr:nth-child(even) { background: #25272b; }"
+          ".num { text-align: right; font-variant-numeric: tabular-nums; }"
+          "</style></head><body><table>"
+          "<tr><th>#</th><th>Item</th><th>Category</th><th class=\"num\">Qty</th>"
+          "<th class=\"num\">Weight</th><th class=\"num\">Value</th></tr>";
+
+  static const char* categories[] = { "Weapon", "Armor", "Consumable", "Material", "Quest" };
+  for (int row = 0; row < 1000; ++row) {
+    html << "<tr><td>" << row + 1 << "</td><td>Inventory item " << row * 7919 % 10007
+         << "</td><td>" << categories[row % 5] << "</td><td class=\"num\">" << (row * 37) % 99 + 1
+         << "</td><td class=\"num\">" << ((row * 13) % 500) / 10.0 << "</td><td class=\"num\">"
+         << (row * 131) % 5000 << "</td></tr>";
+  }
+  html << "</table></body></html>";
+  return html.str();
+}
+
+class Benchmark : public LoadListener,
+                  public Logger {
+  RefPtr<Renderer> renderer_;
+  bool loaded_ = false;
+  bool failed_ = false;
+  Options options_;
+
+public:
+  explicit Benchmark(const Options& options) : options_(options) {
+    Config config;
+    Platform::instance().set_config(config);
+    Platform::instance().set_font_loader(GetPlatformFontLoader());
+    Platform::instance().set_file_system(GetPlatformFileSystem("./assets/"));
+    Platform::instance().set_logger(this);
+
+    renderer_ = Renderer::Create();
+  }
+
+  virtual ~Benchmark() {
+    renderer_ = nullptr;
+  }
+
+  std::vector<CaseResult> Run() {
+    std::vector<PageSpec> pages;
+    pages.push_back(PageSpec{ "static_menu", "file:///menu.html", std::string() });
+    pages.push_back(PageSpec{ "animated_hud", "file:///hud.html", std::string() });
+    pages.push_back(PageSpec{ "table_1000_rows", nullptr, BuildTablePage() });
+    pages.push_back(PageSpec{ "text_heavy", "file:///text.html", std::string() });
+
+    const Resolution resolutions[] = { { 1280, 720 }, { 1920, 1080 }, { 2560, 1440 } };
+
+    std::vector<CaseResult> results;
+    for (size_t p = 0; p < pages.size(); ++p) {
+      for (size_t r = 0; r < sizeof(resolutions) / sizeof(resolutions[0]); ++r)
+        results.push_back(RunCase(pages[p], resolutions[r]));
+    }
+    return results;
+  }
+
+  virtual void OnFinishLoading(ultralight::View* caller, uint64_t frame_id, bool is_main_frame,
+                               const String& url) override {
+    if (is_main_frame)
+      loaded_ = true;
+  }
+
+  virtual void OnFailLoading(ultralight::View* caller, uint64_t frame_id, bool is_main_frame,
+                             const String& url, const String& description,
+                             const String& error_domain, int error_code) override {
+    if (is_main_frame)
+      failed_ = true;
+  }
+
+  virtual void LogMessage(LogLevel log_level, const String& message) override {
+    if (log_level == LogLevel::Error)
+      std::cerr << "> " << message.utf8().data() << std::endl;
+  }
+
+private:
+  CaseResult RunCase(const PageSpec& page, Resolution resolution) {
+    CaseResult result;
+    result.page = page.name;
+    result.resolution = resolution;
+    const long peak_rss_before_kb = PeakRSSKilobytes();
+
+    ViewConfig view_config;
+    view_config.is_accelerated = false;
+    view_config.is_transparent = true;
+
+    RefPtr<View> view = renderer_->CreateView(resolution.width, resolution.height, view_config, nullptr);
+    view->set_load_listener(this);
+
+    loaded_ = false;
+    failed_ = false;
+    Clock::time_point load_start = Clock::now();
+    if (page.url)
+      view->LoadURL(page.url);
+    else
+      view->LoadHTML(page.html.c_str());
+
+    // Give up on a page after 10 seconds rather than hanging CI.
+    while (!loaded_ && !failed_ && ElapsedMs(load_start) < 10000.0) {
+      renderer_->Update();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    result.loaded = loaded_;
+    result.load_ms = ElapsedMs(load_start);
+
+    // Staging buffer reused across frames, like UULUERenderTarget::PixelData.
+    std::vector<uint8_t> staging;
+
+    const int total_frames = options_.warmup + options_.frames;
+    for (int frame = 0; frame < total_frames && result.loaded; ++frame) {
+      const bool measured = frame >= options_.warmup;
+      Clock::time_point frame_start = Clock::now();
+
+      Clock::time_point stage_start = Clock::now();
+      renderer_->Update();
+      const double update_ms = ElapsedMs(stage_start);
+
+      stage_start = Clock::now();
+      renderer_->RefreshDisplay(0);
+      renderer_->Render();
+      const double render_ms = ElapsedMs(stage_start);
+
+      BitmapSurface* surface = static_cast<BitmapSurface*>(view->surface());
+      const IntRect dirty = surface->dirty_bounds();
+      const double dirty_pixels = dirty.IsEmpty() ? 0.0 : static_cast<double>(dirty.width()) * dirty.height();
+
+      double copy_ms = 0.0;
+      if (!dirty.IsEmpty()) {
+        stage_start = Clock::now();
+        CopyFlipped(surface->bitmap(), staging);
+        copy_ms = ElapsedMs(stage_start);
+        surface->ClearDirtyBounds();
+      }
+
+      const double frame_ms = ElapsedMs(frame_start);
+      if (measured) {
+        result.frame_ms.Add(frame_ms);
+        result.update_ms.Add(update_ms);
+        result.render_ms.Add(render_ms);
+        result.copy_ms.Add(copy_ms);
+        result.dirty_pixels.Add(dirty_pixels);
+      }
+
+      // Pace at 60 Hz so time-based CSS animations dirty the same amount per frame on every machine.
+      if (options_.paced && frame_ms < 1000.0 / 60.0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(
+          static_cast<long long>((1000.0 / 60.0 - frame_ms) * 1000.0)));
+      }
+    }
+
+    view->set_load_listener(nullptr);
+    view = nullptr;
+    result.peak_rss_growth_kb = PeakRSSKilobytes() - peak_rss_before_kb;
+
+    std::cerr << page.name << " @ " << resolution.width << "x" << resolution.height
+              << (result.loaded ? "" : " (failed to load)") << ": frame mean "
+              << result.frame_ms.Mean() << " ms, copy mean " << result.copy_ms.Mean() << " ms"
+              << std::endl;
+    return result;
+  }
+
+  ///
+  /// Same work as UULUERenderTarget::OnUltralightDraw: lock, 180-degree flip into staging, unlock.
+  ///
+  static void CopyFlipped(RefPtr<Bitmap> bitmap, std::vector<uint8_t>& staging) {
+    const uint32_t row_bytes = bitmap->row_bytes();
+    const uint32_t height = bitmap->height();
+    const uint32_t pixels_per_row = row_bytes / 4;
+    staging.resize(static_cast<size_t>(row_bytes) * height);
+
+    const uint8_t* src = static_cast<const uint8_t*>(bitmap->LockPixels());
+    if (!src) {
+      bitmap->UnlockPixels();
+      return;
+    }
+
+    uint8_t* dst = staging.data();
+    for (uint32_t row = 0; row < height; ++row) {
+      const uint8_t* src_row = src + static_cast<size_t>(height - 1 - row) * row_bytes;
+      uint8_t* dst_row = dst + static_cast<size_t>(row) * row_bytes;
+      for (uint32_t col = 0; col < pixels_per_row; ++col)
+        std::memcpy(dst_row + col * 4, src_row + (pixels_per_row - 1 - col) * 4, 4);
+    }
+
+    bitmap->UnlockPixels();
+  }
+};
+
+static std::string ToJson(const std::vector<CaseResult>& results, const Options& options) {
+  std::ostringstream out;
+  out << "{\n  \"benchmark\": \"ultralight_cpu_render\",\n"
+      << "  \"frames\": " << options.frames << ",\n"
+      << "  \"warmup\": " << options.warmup << ",\n"
+      << "  \"paced\": " << (options.paced ? "true" : "false") << ",\n"
+      << "  \"peak_rss_kb\": " << PeakRSSKilobytes() << ",\n"
+      << "  \"cases\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const CaseResult& r = results[i];
+    out << "    {\"page\": \"" << r.page << "\", \"width\": " << r.resolution.width
+        << ", \"height\": " << r.resolution.height << ", \"loaded\": " << (r.loaded ? "true" : "false")
+        << ", \"load_ms\": " << r.load_ms
+        << ",\n     \"frame_ms\": " << r.frame_ms.ToJson()
+        << ",\n     \"update_ms\": " << r.update_ms.ToJson()
+        << ",\n     \"render_ms\": " << r.render_ms.ToJson()
+        << ",\n     \"copy_ms\": " << r.copy_ms.ToJson()
+        << ",\n     \"dirty_pixels\": " << r.dirty_pixels.ToJson()
+        << ",\n     \"peak_rss_growth_kb\": " << r.peak_rss_growth_kb << "}"
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+  return out.str();
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--frames") && i + 1 < argc)
+      options.frames = std::max(1, std::atoi(argv[++i]));
+    else if (!std::strcmp(argv[i], "--warmup") && i + 1 < argc)
+      options.warmup = std::max(0, std::atoi(argv[++i]));
+    else if (!std::strcmp(argv[i], "--unpaced"))
+      options.paced = false;
+    else if (!std::strcmp(argv[i], "--out") && i + 1 < argc)
+      options.out_path = argv[++i];
+    else {
+      std::cerr << "Usage: " << argv[0] << " [--frames N] [--warmup N] [--unpaced] [--out results.json]"
+                << std::endl;
+      return 2;
+    }
+  }
+
+  std::vector<CaseResult> results;
+  {
+    Benchmark benchmark(options);
+    results = benchmark.Run();
+  }
+
+  const std::string json = ToJson(results, options);
+  if (options.out_path.empty()) {
+    std::cout << json;
+  } else {
+    std::ofstream file(options.out_path.c_str());
+    file << json;
+  }
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (!results[i].loaded)
+      return 1;
+  }
+  return 0;
+}
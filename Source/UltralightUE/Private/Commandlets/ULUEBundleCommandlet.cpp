@@ -0,0 +1,34 @@
+/*
+ * Cook step that packs Content/uicontent into a single indexed UI bundle (see FULUEBundle).
+ */
+
+#include "Commandlets/ULUEBundleCommandlet.h"
+#include "FileSystem/ULUEBundle.h"
+#include "Fonts/ULUEFontLoader.h"
+#include "Misc/Paths.h"
+
+UUltralightBundleCommandlet::UUltralightBundleCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UUltralightBundleCommandlet::Main(const FString& Params)
+{
+	FString SourceDirectory = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("uicontent"));
+	FParse::Value(*Params, TEXT("Source="), SourceDirectory);
+
+	FString OutputPath = ultralightue::GetDefaultBundlePath();
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	ultralightue::FULUEBundleWriteOptions Options;
+	Options.bCompress = FParse::Param(*Params, TEXT("Compress"));
+	FParse::Value(*Params, TEXT("Align="), Options.Alignment);
+
+	// Shipped fonts resolve through a precomputed index instead of being parsed at startup.
+	ultralightue::WriteFontIndex(SourceDirectory);
+
+	return ultralightue::WriteUltralightBundle(SourceDirectory, OutputPath, Options) ? 0 : 1;
+}
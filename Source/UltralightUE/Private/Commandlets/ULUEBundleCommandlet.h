@@ -0,0 +1,25 @@
+/*
+ * Cook step that packs Content/uicontent into a single indexed UI bundle (see FULUEBundle).
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ULUEBundleCommandlet.generated.h"
+
+/**
+ * UnrealEditor-Cmd <Project>.uproject -run=UltralightBundle [-Source=<dir>] [-Output=<file>] [-Compress] [-Align=<bytes>]
+ * Defaults: Source is Content/uicontent, Output is Content/UltralightBundle/uicontent.ulbundle, 64-byte alignment.
+ * Regenerates Source/fonts/fontindex.txt (see ULUEFontLoader) before packing.
+ */
+UCLASS()
+class UUltralightBundleCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUltralightBundleCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
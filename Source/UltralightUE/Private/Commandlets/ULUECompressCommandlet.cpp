@@ -0,0 +1,239 @@
+/*
+ * Cook step that writes precompressed .ulz siblings for UI content (see ULUECompressedFile.h).
+ */
+
+#include "Commandlets/ULUECompressCommandlet.h"
+#include "FileSystem/ULUECompressedFile.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ULUELogInterface.h"
+
+using namespace ultralightue;
+
+namespace
+{
+	/// Formats that are already compressed; recompressing them only costs decode time.
+	bool IsAlreadyCompressed(const FString& Extension)
+	{
+		static const TSet<FString> Extensions = { TEXT("png"), TEXT("jpg"), TEXT("jpeg"), TEXT("gif"), TEXT("webp"), TEXT("woff"), TEXT("woff2"), TEXT("mp3"), TEXT("mp4"), TEXT("ogg"), TEXT("webm") };
+		return Extensions.Contains(Extension);
+	}
+
+	/// Section of Config/DefaultPakFileRules.ini owned by this commandlet.
+	const TCHAR* PakRulesSection = TEXT("[UltralightPrecompressedOriginals]");
+
+	/**
+	 * Rewrites our section of DefaultPakFileRules.ini so the originals of precompressed files stay out of the paks
+	 * (cooked builds serve the .ulz sibling in their place). Other sections are kept as they are.
+	 * Originals are paths relative to the project directory; an empty list just removes the section.
+	 */
+	bool WritePakFileRules(const TArray<FString>& Originals)
+	{
+		const FString RulesPath = FPaths::Combine(FPaths::ProjectConfigDir(), TEXT("DefaultPakFileRules.ini"));
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *RulesPath);
+
+		TArray<FString> Kept;
+		bool bInSection = false;
+		for (const FString& Line : Lines)
+		{
+			const FString Trimmed = Line.TrimStartAndEnd();
+			if (Trimmed.StartsWith(TEXT("[")))
+			{
+				bInSection = Trimmed == PakRulesSection;
+			}
+			if (!bInSection)
+			{
+				Kept.Add(Line);
+			}
+		}
+		while (Kept.Num() > 0 && Kept.Last().TrimStartAndEnd().IsEmpty())
+		{
+			Kept.Pop();
+		}
+
+		if (Originals.Num() > 0)
+		{
+			if (Kept.Num() > 0)
+			{
+				Kept.Add(FString());
+			}
+			Kept.Add(PakRulesSection);
+			Kept.Add(TEXT("; Written by -run=UltralightCompress. Cooked builds read the .ulz sibling of these files instead."));
+			Kept.Add(TEXT("bExcludeFromPaks=true"));
+			for (const FString& Original : Originals)
+			{
+				Kept.Add(FString::Printf(TEXT("+Files=\".../%s/%s\""), FApp::GetProjectName(), *Original));
+			}
+		}
+
+		if (Kept.Num() == 0)
+		{
+			IFileManager::Get().Delete(*RulesPath, false, false, true);
+			return true;
+		}
+		return FFileHelper::SaveStringArrayToFile(Kept, *RulesPath);
+	}
+
+	bool ParseCodec(const FString& Name, EULUECompressionCodec& OutCodec)
+	{
+		if (Name.Equals(TEXT("Oodle"), ESearchCase::IgnoreCase))
+		{
+			OutCodec = EULUECompressionCodec::Oodle;
+		}
+		else if (Name.Equals(TEXT("Zlib"), ESearchCase::IgnoreCase))
+		{
+			OutCodec = EULUECompressionCodec::Zlib;
+		}
+		else if (Name.Equals(TEXT("LZ4"), ESearchCase::IgnoreCase))
+		{
+			OutCodec = EULUECompressionCodec::LZ4;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+}
+
+UUltralightCompressCommandlet::UUltralightCompressCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UUltralightCompressCommandlet::Main(const FString& Params)
+{
+	FString SourceDirectory = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("uicontent"));
+	FParse::Value(*Params, TEXT("Source="), SourceDirectory);
+
+	FString CodecName = TEXT("Oodle");
+	FParse::Value(*Params, TEXT("Codec="), CodecName);
+	EULUECompressionCodec Codec = EULUECompressionCodec::Oodle;
+	if (!ParseCodec(CodecName, Codec))
+	{
+		UE_LOG(LogUltralightUE, Error, TEXT("Unknown codec '%s' (expected Oodle, Zlib or LZ4)"), *CodecName);
+		return 1;
+	}
+
+	uint32 BlockKB = CompressedFile::DefaultBlockSize / 1024;
+	uint32 MinSizeKB = 4;
+	float MaxRatio = 0.9f;
+	FParse::Value(*Params, TEXT("BlockKB="), BlockKB);
+	FParse::Value(*Params, TEXT("MinSizeKB="), MinSizeKB);
+	FParse::Value(*Params, TEXT("MaxRatio="), MaxRatio);
+	const bool bCleanOnly = FParse::Param(*Params, TEXT("Clean"));
+	const bool bKeepOriginals = FParse::Param(*Params, TEXT("KeepOriginals"));
+	const FString ProjectDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *SourceDirectory, TEXT("*"), true, false);
+	Files.Sort();
+
+	int32 Compressed = 0;
+	int32 Skipped = 0;
+	int64 RawBytes = 0;
+	int64 EncodedBytes = 0;
+	double EncodeSeconds = 0.0;
+	double DecodeSeconds = 0.0;
+	// Project-relative paths of files that now have a sibling.
+	TArray<FString> Originals;
+
+	for (const FString& File : Files)
+	{
+		if (File.EndsWith(CompressedFile::Extension))
+		{
+			continue;
+		}
+
+		const FString SiblingPath = File + CompressedFile::Extension;
+		const int64 FileSize = IFileManager::Get().FileSize(*File);
+		if (bCleanOnly || FileSize < static_cast<int64>(MinSizeKB) * 1024 || IsAlreadyCompressed(FPaths::GetExtension(File).ToLower()))
+		{
+			IFileManager::Get().Delete(*SiblingPath, false, false, true);
+			++Skipped;
+			continue;
+		}
+
+		TArray<uint8> Raw;
+		if (!FFileHelper::LoadFileToArray(Raw, *File))
+		{
+			UE_LOG(LogUltralightUE, Error, TEXT("Failed to read %s"), *File);
+			return 1;
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		TArray<uint8> Encoded;
+		if (!EncodeCompressedFile(Raw, Codec, BlockKB * 1024, Encoded))
+		{
+			UE_LOG(LogUltralightUE, Error, TEXT("Failed to compress %s"), *File);
+			return 1;
+		}
+		const double FileEncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const double Ratio = static_cast<double>(Encoded.Num()) / Raw.Num();
+		if (Ratio > MaxRatio)
+		{
+			IFileManager::Get().Delete(*SiblingPath, false, false, true);
+			++Skipped;
+			continue;
+		}
+
+		// Round-trip every file: proves the sibling is valid and measures what the runtime will pay.
+		StartTime = FPlatformTime::Seconds();
+		TArray<uint8> Decoded;
+		if (!DecodeCompressedFile(Encoded, Decoded) || Decoded != Raw)
+		{
+			UE_LOG(LogUltralightUE, Error, TEXT("Round trip failed for %s"), *File);
+			return 1;
+		}
+		const double FileDecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		if (!FFileHelper::SaveArrayToFile(Encoded, *SiblingPath))
+		{
+			UE_LOG(LogUltralightUE, Error, TEXT("Failed to write %s"), *SiblingPath);
+			return 1;
+		}
+
+		UE_LOG(LogUltralightUE, Display, TEXT("%s: %lld -> %d bytes (%.2f), encode %.2f ms, decode %.2f ms"),
+			*File, static_cast<int64>(Raw.Num()), Encoded.Num(), Ratio, FileEncodeSeconds * 1000.0, FileDecodeSeconds * 1000.0);
+
+		FString Original = FPaths::ConvertRelativePathToFull(File);
+		if (FPaths::MakePathRelativeTo(Original, *ProjectDirectory) && !Original.StartsWith(TEXT("..")))
+		{
+			Originals.Add(MoveTemp(Original));
+		}
+		else if (!bKeepOriginals)
+		{
+			UE_LOG(LogUltralightUE, Warning, TEXT("%s is outside the project; its original will still be staged"), *File);
+		}
+
+		++Compressed;
+		RawBytes += Raw.Num();
+		EncodedBytes += Encoded.Num();
+		EncodeSeconds += FileEncodeSeconds;
+		DecodeSeconds += FileDecodeSeconds;
+	}
+
+	UE_LOG(LogUltralightUE, Display, TEXT("%s: %d files precompressed with %s, %d left raw; %lld KB -> %lld KB (ratio %.2f), encode %.1f ms, decode %.1f ms"),
+		*SourceDirectory, Compressed, *CodecName, Skipped, RawBytes / 1024, EncodedBytes / 1024,
+		RawBytes > 0 ? static_cast<double>(EncodedBytes) / RawBytes : 0.0, EncodeSeconds * 1000.0, DecodeSeconds * 1000.0);
+
+	// Staging copies the whole uicontent directory, so without these rules the pak would carry both versions.
+	if (bKeepOriginals)
+	{
+		Originals.Reset();
+	}
+	if (!WritePakFileRules(Originals))
+	{
+		UE_LOG(LogUltralightUE, Error, TEXT("Failed to update %s"), *FPaths::Combine(FPaths::ProjectConfigDir(), TEXT("DefaultPakFileRules.ini")));
+		return 1;
+	}
+	UE_LOG(LogUltralightUE, Display, TEXT("%d originals excluded from paks via DefaultPakFileRules.ini %s"), Originals.Num(), PakRulesSection);
+	return 0;
+}
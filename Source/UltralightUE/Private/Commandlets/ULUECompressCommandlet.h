@@ -0,0 +1,28 @@
+/*
+ * Cook step that writes precompressed .ulz siblings for UI content (see ULUECompressedFile.h).
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ULUECompressCommandlet.generated.h"
+
+/**
+ * UnrealEditor-Cmd <Project>.uproject -run=UltralightCompress [-Source=<dir>] [-Codec=Oodle|Zlib|LZ4]
+ *     [-BlockKB=256] [-MinSizeKB=4] [-MaxRatio=0.9] [-Clean] [-KeepOriginals]
+ * Writes <file>.ulz next to every file that compresses below MaxRatio, removes stale siblings for files that
+ * no longer qualify, and prints the compression ratio and measured decode time. -Clean only removes siblings.
+ * The originals of compressed files are excluded from paks through a section of Config/DefaultPakFileRules.ini
+ * that is rewritten on every run; -KeepOriginals (or -Clean) removes it so both versions ship.
+ */
+UCLASS()
+class UUltralightCompressCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUltralightCompressCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,429 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#include "FileSystem/ULUEBundle.h"
+#include "FileSystem/ULUECompressedFile.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ULUELogInterface.h"
+
+namespace ultralightue
+{
+    namespace
+    {
+        /// Average keys per displacement bucket; higher means a smaller seed table and a slower build.
+        constexpr uint32 KeysPerBucket = 4;
+        constexpr uint32 MaxSeedAttempts = 1u << 24;
+
+        /// Entry inside a bundle. Holds the bundle storage alive; costs no heap of its own.
+        class FULUESliceFileBlob final : public FULUEFileBlob
+        {
+        public:
+            FULUESliceFileBlob(FULUEFileBlobPtr InParent, const uint8* InData, int64 InSize)
+                : Parent(MoveTemp(InParent))
+            {
+                Data = InData;
+                Size = InSize;
+            }
+
+            virtual int64 GetResidentBytes() const override { return 0; }
+
+        private:
+            FULUEFileBlobPtr Parent;
+        };
+
+        FString NormalizeBundlePath(FStringView RelativePath)
+        {
+            FString Key(RelativePath);
+            Key.ReplaceCharInline(TEXT('\\'), TEXT('/'));
+            int32 FirstChar = 0;
+            while (FirstChar < Key.Len() && Key[FirstChar] == TEXT('/'))
+            {
+                ++FirstChar;
+            }
+            Key.RightChopInline(FirstChar);
+            Key.ToLowerInline();
+            return Key;
+        }
+
+        uint64 HashBucket(const char* Key, uint32 Length)
+        {
+            return CityHash64(Key, Length);
+        }
+
+        uint64 HashSlot(const char* Key, uint32 Length, uint32 Seed)
+        {
+            return CityHash64WithSeed(Key, Length, Seed);
+        }
+
+        uint64 AlignOffset(uint64 Offset, uint32 Alignment)
+        {
+            return (Offset + Alignment - 1) & ~static_cast<uint64>(Alignment - 1);
+        }
+
+        /// Hash-and-displace: place the largest buckets first, trying seeds until every key in the bucket lands
+        /// on a free slot. Produces a minimal perfect hash (slot count == key count).
+        bool BuildPerfectHash(const TArray<TArray<ANSICHAR>>& Keys, uint32 NumBuckets, TArray<uint32>& OutSeeds, TArray<int32>& OutKeyForSlot)
+        {
+            const uint32 NumSlots = Keys.Num();
+
+            TArray<TArray<int32>> Buckets;
+            Buckets.SetNum(NumBuckets);
+            for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); ++KeyIndex)
+            {
+                const TArray<ANSICHAR>& Key = Keys[KeyIndex];
+                Buckets[HashBucket(Key.GetData(), Key.Num()) % NumBuckets].Add(KeyIndex);
+            }
+
+            TArray<int32> Order;
+            Order.Reserve(NumBuckets);
+            for (uint32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+            {
+                Order.Add(Bucket);
+            }
+            Order.StableSort([&Buckets](int32 A, int32 B) { return Buckets[A].Num() > Buckets[B].Num(); });
+
+            OutSeeds.Init(0, NumBuckets);
+            OutKeyForSlot.Init(INDEX_NONE, NumSlots);
+
+            TArray<uint32, TInlineAllocator<16>> Slots;
+            for (const int32 Bucket : Order)
+            {
+                const TArray<int32>& Members = Buckets[Bucket];
+                if (Members.Num() == 0)
+                {
+                    break;
+                }
+
+                bool bPlaced = false;
+                for (uint32 Seed = 1; Seed < MaxSeedAttempts && !bPlaced; ++Seed)
+                {
+                    Slots.Reset();
+                    bPlaced = true;
+                    for (const int32 KeyIndex : Members)
+                    {
+                        const TArray<ANSICHAR>& Key = Keys[KeyIndex];
+                        const uint32 Slot = static_cast<uint32>(HashSlot(Key.GetData(), Key.Num(), Seed) % NumSlots);
+                        if (OutKeyForSlot[Slot] != INDEX_NONE || Slots.Contains(Slot))
+                        {
+                            bPlaced = false;
+                            break;
+                        }
+                        Slots.Add(Slot);
+                    }
+
+                    if (bPlaced)
+                    {
+                        OutSeeds[Bucket] = Seed;
+                        for (int32 Index = 0; Index < Members.Num(); ++Index)
+                        {
+                            OutKeyForSlot[Slots[Index]] = Members[Index];
+                        }
+                    }
+                }
+
+                if (!bPlaced)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    /* -------------------------------------------------------------------------- */
+    /*                              FULUEBundle                                   */
+    /* -------------------------------------------------------------------------- */
+
+    TSharedPtr<FULUEBundle> FULUEBundle::Open(const FString& BundlePath)
+    {
+        if (!IFileManager::Get().FileExists(*BundlePath))
+        {
+            return nullptr;
+        }
+
+        TSharedPtr<FULUEBundle> Bundle = MakeShared<FULUEBundle>();
+        Bundle->Path = BundlePath;
+
+        // Map when possible so entries are zero-copy; a bundle inside a compressed pak has to be read.
+        Bundle->Storage = FULUEMappedFileBlob::Map(BundlePath);
+        if (!Bundle->Storage.IsValid())
+        {
+            TArray<uint8> Contents;
+            if (!FFileHelper::LoadFileToArray(Contents, *BundlePath))
+            {
+                UE_LOG(LogUltralightUE, Warning, TEXT("UI bundle %s could not be read"), *BundlePath);
+                return nullptr;
+            }
+            Bundle->Storage = MakeShared<FULUEHeapFileBlob, ESPMode::ThreadSafe>(MoveTemp(Contents));
+        }
+
+        if (!Bundle->Validate())
+        {
+            UE_LOG(LogUltralightUE, Warning, TEXT("UI bundle %s is malformed or from an incompatible version; ignoring it"), *BundlePath);
+            return nullptr;
+        }
+        return Bundle;
+    }
+
+    bool FULUEBundle::Validate()
+    {
+        const uint8* Base = Storage->GetData();
+        const uint64 FileSize = static_cast<uint64>(Storage->GetSize());
+        if (FileSize < sizeof(FULUEBundleHeader))
+        {
+            return false;
+        }
+
+        FMemory::Memcpy(&Header, Base, sizeof(FULUEBundleHeader));
+        if (Header.Magic != Bundle::Magic || Header.Version != Bundle::Version || Header.NumEntries == 0 || Header.NumBuckets == 0)
+        {
+            return false;
+        }
+
+        const uint64 SeedsBytes = static_cast<uint64>(Header.NumBuckets) * sizeof(uint32);
+        const uint64 EntriesBytes = static_cast<uint64>(Header.NumEntries) * sizeof(FULUEBundleEntry);
+        if (Header.SeedsOffset % alignof(uint32) != 0 || Header.EntriesOffset % alignof(FULUEBundleEntry) != 0
+            || Header.SeedsOffset > FileSize || SeedsBytes > FileSize - Header.SeedsOffset
+            || Header.EntriesOffset > FileSize || EntriesBytes > FileSize - Header.EntriesOffset
+            || Header.PathPoolOffset > FileSize || Header.PathPoolSize > FileSize - Header.PathPoolOffset)
+        {
+            return false;
+        }
+
+        Seeds = reinterpret_cast<const uint32*>(Base + Header.SeedsOffset);
+        Entries = reinterpret_cast<const FULUEBundleEntry*>(Base + Header.EntriesOffset);
+        PathPool = reinterpret_cast<const ANSICHAR*>(Base + Header.PathPoolOffset);
+
+        for (uint32 Index = 0; Index < Header.NumEntries; ++Index)
+        {
+            const FULUEBundleEntry& Entry = Entries[Index];
+            if (Entry.Offset > FileSize || Entry.Size > FileSize - Entry.Offset
+                || static_cast<uint64>(Entry.PathOffset) + Entry.PathLength > Header.PathPoolSize
+                || (Entry.Compression == EULUEBundleCompression::None && Entry.UncompressedSize != Entry.Size)
+                // Decompression takes int32 sizes.
+                || Entry.Size > static_cast<uint64>(MAX_int32) || Entry.UncompressedSize > static_cast<uint64>(MAX_int32)
+                || Entry.Compression > EULUEBundleCompression::Oodle)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const FULUEBundleEntry* FULUEBundle::FindEntry(FStringView RelativePath) const
+    {
+        const FString Key = NormalizeBundlePath(RelativePath);
+        const FTCHARToUTF8 Utf8Key(*Key);
+        const char* KeyData = reinterpret_cast<const char*>(Utf8Key.Get());
+        const uint32 KeyLength = static_cast<uint32>(Utf8Key.Length());
+
+        const uint32 Seed = Seeds[HashBucket(KeyData, KeyLength) % Header.NumBuckets];
+        const FULUEBundleEntry& Entry = Entries[HashSlot(KeyData, KeyLength, Seed) % Header.NumEntries];
+
+        // Every slot is occupied, so a path that isn't in the bundle still lands somewhere; compare to be sure.
+        if (Entry.PathLength != KeyLength || FMemory::Memcmp(PathPool + Entry.PathOffset, KeyData, KeyLength) != 0)
+        {
+            return nullptr;
+        }
+        return &Entry;
+    }
+
+    bool FULUEBundle::Contains(FStringView RelativePath) const
+    {
+        return FindEntry(RelativePath) != nullptr;
+    }
+
+    FULUEFileBlobPtr FULUEBundle::Find(FStringView RelativePath) const
+    {
+        const FULUEBundleEntry* Entry = FindEntry(RelativePath);
+        if (!Entry)
+        {
+            return nullptr;
+        }
+        // Empty files exist (Contains says so) and open as empty, rather than failing in OpenFile.
+        if (Entry->UncompressedSize == 0)
+        {
+            return MakeShared<FULUEHeapFileBlob, ESPMode::ThreadSafe>(TArray<uint8>());
+        }
+
+        const uint8* Payload = Storage->GetData() + Entry->Offset;
+        if (Entry->Compression == EULUEBundleCompression::None)
+        {
+            return MakeShared<FULUESliceFileBlob, ESPMode::ThreadSafe>(Storage, Payload, static_cast<int64>(Entry->Size));
+        }
+
+        TArray<uint8> Decoded;
+        Decoded.SetNumUninitialized(static_cast<int64>(Entry->UncompressedSize));
+        if (!FCompression::UncompressMemory(NAME_Oodle, Decoded.GetData(), static_cast<int32>(Entry->UncompressedSize), Payload, static_cast<int32>(Entry->Size)))
+        {
+            UE_LOG(LogUltralightUE, Warning, TEXT("UI bundle %s: failed to decompress %.*s"), *Path, RelativePath.Len(), RelativePath.GetData());
+            return nullptr;
+        }
+        return MakeShared<FULUEHeapFileBlob, ESPMode::ThreadSafe>(MoveTemp(Decoded));
+    }
+
+    /* -------------------------------------------------------------------------- */
+    /*                              Bundle writer                                 */
+    /* -------------------------------------------------------------------------- */
+
+    bool WriteUltralightBundle(const FString& SourceDirectory, const FString& OutputPath, const FULUEBundleWriteOptions& Options)
+    {
+        if (!FMath::IsPowerOfTwo(Options.Alignment) || Options.Alignment < alignof(FULUEBundleEntry))
+        {
+            UE_LOG(LogUltralightUE, Error, TEXT("Bundle alignment must be a power of two and at least %d (got %u)"), static_cast<int32>(alignof(FULUEBundleEntry)), Options.Alignment);
+            return false;
+        }
+
+        TArray<FString> Files;
+        IFileManager::Get().FindFilesRecursive(Files, *SourceDirectory, TEXT("*"), true, false);
+        // Precompressed siblings are redundant inside a bundle, which compresses per entry.
+        Files.RemoveAll([](const FString& File) { return File.EndsWith(CompressedFile::Extension); });
+        if (Files.Num() == 0)
+        {
+            UE_LOG(LogUltralightUE, Error, TEXT("No files to bundle under %s"), *SourceDirectory);
+            return false;
+        }
+        Files.Sort();
+
+        struct FPendingEntry
+        {
+            FString SourcePath;
+            TArray<uint8> Payload;
+            uint64 UncompressedSize = 0;
+            EULUEBundleCompression Compression = EULUEBundleCompression::None;
+        };
+
+        TArray<FPendingEntry> Pending;
+        TArray<TArray<ANSICHAR>> Keys;
+        TMap<FString, FString> KeyOwners;
+        const FString SourceRoot = FPaths::ConvertRelativePathToFull(SourceDirectory) / TEXT("");
+        uint64 RawBytes = 0;
+        uint64 StoredBytes = 0;
+
+        for (const FString& File : Files)
+        {
+            FString Relative = FPaths::ConvertRelativePathToFull(File);
+            FPaths::MakePathRelativeTo(Relative, *SourceRoot);
+            const FString Key = NormalizeBundlePath(Relative);
+
+            // Lookups are case-insensitive, so two files differing only in case can't both be served.
+            if (const FString* Owner = KeyOwners.Find(Key))
+            {
+                UE_LOG(LogUltralightUE, Error, TEXT("%s and %s map to the same bundle path"), **Owner, *File);
+                return false;
+            }
+            KeyOwners.Add(Key, File);
+
+            const FTCHARToUTF8 Utf8Key(*Key);
+            if (Utf8Key.Length() > MAX_uint16)
+            {
+                UE_LOG(LogUltralightUE, Error, TEXT("Path too long for bundle: %s"), *File);
+                return false;
+            }
+            Keys.Emplace(reinterpret_cast<const ANSICHAR*>(Utf8Key.Get()), Utf8Key.Length());
+
+            FPendingEntry& Entry = Pending.AddDefaulted_GetRef();
+            Entry.SourcePath = File;
+            if (!FFileHelper::LoadFileToArray(Entry.Payload, *File))
+            {
+                UE_LOG(LogUltralightUE, Error, TEXT("Failed to read %s"), *File);
+                return false;
+            }
+            Entry.UncompressedSize = Entry.Payload.Num();
+
+            if (Options.bCompress && Entry.Payload.Num() > 0)
+            {
+                int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Entry.Payload.Num());
+                TArray<uint8> Compressed;
+                Compressed.SetNumUninitialized(CompressedSize);
+                if (FCompression::CompressMemory(NAME_Oodle, Compressed.GetData(), CompressedSize, Entry.Payload.GetData(), Entry.Payload.Num())
+                    && CompressedSize < Entry.Payload.Num() - Entry.Payload.Num() / 10)
+                {
+                    Compressed.SetNum(CompressedSize);
+                    Entry.Payload = MoveTemp(Compressed);
+                    Entry.Compression = EULUEBundleCompression::Oodle;
+                }
+            }
+
+            RawBytes += Entry.UncompressedSize;
+            StoredBytes += Entry.Payload.Num();
+        }
+
+        const uint32 NumEntries = Pending.Num();
+        const uint32 NumBuckets = FMath::Max(1u, (NumEntries + KeysPerBucket - 1) / KeysPerBucket);
+        TArray<uint32> Seeds;
+        TArray<int32> EntryForSlot;
+        if (!BuildPerfectHash(Keys, NumBuckets, Seeds, EntryForSlot))
+        {
+            UE_LOG(LogUltralightUE, Error, TEXT("Failed to build a perfect hash for %u bundle entries"), NumEntries);
+            return false;
+        }
+
+        FULUEBundleHeader Header;
+        Header.Magic = Bundle::Magic;
+        Header.Version = Bundle::Version;
+        Header.NumEntries = NumEntries;
+        Header.NumBuckets = NumBuckets;
+        Header.DataAlignment = Options.Alignment;
+        Header.SeedsOffset = sizeof(FULUEBundleHeader);
+        Header.EntriesOffset = AlignOffset(Header.SeedsOffset + NumBuckets * sizeof(uint32), alignof(FULUEBundleEntry));
+        Header.PathPoolOffset = Header.EntriesOffset + static_cast<uint64>(NumEntries) * sizeof(FULUEBundleEntry);
+
+        TArray<FULUEBundleEntry> Entries;
+        Entries.SetNum(NumEntries);
+        TArray<ANSICHAR> PathPool;
+        for (uint32 Slot = 0; Slot < NumEntries; ++Slot)
+        {
+            const int32 Source = EntryForSlot[Slot];
+            FULUEBundleEntry& Entry = Entries[Slot];
+            Entry.PathOffset = PathPool.Num();
+            Entry.PathLength = static_cast<uint16>(Keys[Source].Num());
+            PathPool.Append(Keys[Source]);
+            Entry.Size = Pending[Source].Payload.Num();
+            Entry.UncompressedSize = Pending[Source].UncompressedSize;
+            Entry.Compression = Pending[Source].Compression;
+        }
+        Header.PathPoolSize = PathPool.Num();
+
+        // Payloads follow the index in slot order, each on an aligned boundary.
+        uint64 PayloadOffset = AlignOffset(Header.PathPoolOffset + Header.PathPoolSize, Options.Alignment);
+        for (uint32 Slot = 0; Slot < NumEntries; ++Slot)
+        {
+            Entries[Slot].Offset = PayloadOffset;
+            PayloadOffset = AlignOffset(PayloadOffset + Entries[Slot].Size, Options.Alignment);
+        }
+
+        TArray64<uint8> Output;
+        Output.SetNumZeroed(PayloadOffset);
+        FMemory::Memcpy(Output.GetData(), &Header, sizeof(Header));
+        FMemory::Memcpy(Output.GetData() + Header.SeedsOffset, Seeds.GetData(), Seeds.Num() * sizeof(uint32));
+        FMemory::Memcpy(Output.GetData() + Header.EntriesOffset, Entries.GetData(), Entries.Num() * sizeof(FULUEBundleEntry));
+        FMemory::Memcpy(Output.GetData() + Header.PathPoolOffset, PathPool.GetData(), PathPool.Num());
+        for (uint32 Slot = 0; Slot < NumEntries; ++Slot)
+        {
+            const TArray<uint8>& Payload = Pending[EntryForSlot[Slot]].Payload;
+            FMemory::Memcpy(Output.GetData() + Entries[Slot].Offset, Payload.GetData(), Payload.Num());
+        }
+
+        if (!FFileHelper::SaveArrayToFile(Output, *OutputPath))
+        {
+            UE_LOG(LogUltralightUE, Error, TEXT("Failed to write bundle %s"), *OutputPath);
+            return false;
+        }
+
+        UE_LOG(LogUltralightUE, Display, TEXT("Wrote %s: %u files, %llu KB of content stored as %llu KB, bundle %lld KB"),
+            *OutputPath, NumEntries, RawBytes / 1024, StoredBytes / 1024, Output.Num() / 1024);
+        return true;
+    }
+
+    FString GetDefaultBundlePath()
+    {
+        return FPaths::ProjectContentDir() / TEXT("UltralightBundle/uicontent.ulbundle");
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileSystem/ULUEFileCache.h"
+
+namespace ultralightue
+{
+    /// @brief Cooked UI bundle: the whole uicontent tree packed into one file with a minimal perfect-hash index.
+    ///
+    /// Layout (little endian):
+    ///   FULUEBundleHeader
+    ///   uint32 Seeds[NumBuckets]        hash-and-displace table; Seeds[Hash(Path) % NumBuckets] picks the slot hash
+    ///   FULUEBundleEntry Entries[N]     indexed by slot, N == NumEntries
+    ///   char PathPool[PathPoolSize]     lowercase, '/'-separated paths relative to uicontent, used to confirm a hit
+    ///   payloads                        each starting on a DataAlignment boundary
+    namespace Bundle
+    {
+        constexpr uint32 Magic = 0x424C5555; // "UULB"
+        constexpr uint32 Version = 1;
+        constexpr uint32 DefaultAlignment = 64;
+    }
+
+    enum class EULUEBundleCompression : uint8
+    {
+        None = 0,
+        Oodle = 1,
+    };
+
+    struct FULUEBundleHeader
+    {
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        uint32 NumEntries = 0;
+        uint32 NumBuckets = 0;
+        uint32 DataAlignment = 0;
+        uint32 Reserved = 0;
+        uint64 SeedsOffset = 0;
+        uint64 EntriesOffset = 0;
+        uint64 PathPoolOffset = 0;
+        uint64 PathPoolSize = 0;
+    };
+    static_assert(sizeof(FULUEBundleHeader) == 56, "Bundle header layout is part of the file format");
+
+    struct FULUEBundleEntry
+    {
+        uint64 Offset = 0;           /// Payload offset from the start of the bundle.
+        uint64 Size = 0;             /// Payload size as stored.
+        uint64 UncompressedSize = 0; /// Equal to Size for uncompressed entries.
+        uint32 PathOffset = 0;
+        uint16 PathLength = 0;
+        EULUEBundleCompression Compression = EULUEBundleCompression::None;
+        uint8 Reserved = 0;
+    };
+    static_assert(sizeof(FULUEBundleEntry) == 32, "Bundle entry layout is part of the file format");
+
+    struct FULUEBundleWriteOptions
+    {
+        /// Oodle-compress entries when it saves at least 10%. Compressed entries are decoded into the file cache
+        /// on first use instead of being served straight from the mapping.
+        bool bCompress = false;
+        uint32 Alignment = Bundle::DefaultAlignment;
+    };
+
+    /// @brief Read-only view of a bundle. The bundle file is mapped when the platform allows it, otherwise read
+    /// into memory once; uncompressed entries are served as slices of it without copying.
+    class FULUEBundle
+    {
+    public:
+        /// Opens and validates a bundle, or returns null (and logs why) if it is missing or malformed.
+        static TSharedPtr<FULUEBundle> Open(const FString& BundlePath);
+
+        /// Path relative to uicontent, any case and either slash. Returns null if the bundle doesn't contain it.
+        FULUEFileBlobPtr Find(FStringView RelativePath) const;
+        bool Contains(FStringView RelativePath) const;
+
+        int32 Num() const { return static_cast<int32>(Header.NumEntries); }
+        const FString& GetPath() const { return Path; }
+
+    private:
+        const FULUEBundleEntry* FindEntry(FStringView RelativePath) const;
+        bool Validate();
+
+        FString Path;
+        FULUEFileBlobPtr Storage;
+        FULUEBundleHeader Header;
+        const uint32* Seeds = nullptr;
+        const FULUEBundleEntry* Entries = nullptr;
+        const ANSICHAR* PathPool = nullptr;
+    };
+
+    /// @brief Packs every file under SourceDirectory into a bundle at OutputPath.
+    bool WriteUltralightBundle(const FString& SourceDirectory, const FString& OutputPath, const FULUEBundleWriteOptions& Options);
+
+    /// @brief Where the cook step writes the bundle and where the file system looks for it at startup.
+    FString GetDefaultBundlePath();
+}
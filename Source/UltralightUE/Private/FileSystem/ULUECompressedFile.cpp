@@ -0,0 +1,185 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#include "FileSystem/ULUECompressedFile.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "ULUELogInterface.h"
+#include "ULUEStats.h"
+#include <atomic>
+
+namespace ultralightue
+{
+    namespace
+    {
+        std::atomic<int64> GDecodedFiles{ 0 };
+        std::atomic<int64> GCompressedBytes{ 0 };
+        std::atomic<int64> GDecodedBytes{ 0 };
+        std::atomic<uint64> GDecodeCycles{ 0 };
+
+        FAutoConsoleCommand GLogFileCompressionCommand(
+            TEXT("Ultralight.LogFileCompression"),
+            TEXT("Logs how much precompressed UI content has been decoded, the overall ratio and the time spent decoding."),
+            FConsoleCommandDelegate::CreateLambda([]()
+            {
+                const FULUEDecompressionReport Report = GetDecompressionReport();
+                UE_LOG(LogUltralightUE, Display, TEXT("Precompressed files: %lld decoded, %lld KB -> %lld KB (ratio %.2f), %.2f ms decoding (%.1f MB/s)"),
+                    Report.Files,
+                    Report.CompressedBytes / 1024,
+                    Report.DecodedBytes / 1024,
+                    Report.DecodedBytes > 0 ? static_cast<double>(Report.CompressedBytes) / Report.DecodedBytes : 0.0,
+                    Report.DecodeSeconds * 1000.0,
+                    Report.DecodeSeconds > 0.0 ? Report.DecodedBytes / (1024.0 * 1024.0) / Report.DecodeSeconds : 0.0);
+            }));
+    }
+
+    FName GetCompressionFormat(EULUECompressionCodec Codec)
+    {
+        switch (Codec)
+        {
+        case EULUECompressionCodec::Oodle:
+            return NAME_Oodle;
+        case EULUECompressionCodec::Zlib:
+            return NAME_Zlib;
+        case EULUECompressionCodec::LZ4:
+            return NAME_LZ4;
+        default:
+            return NAME_None;
+        }
+    }
+
+    bool EncodeCompressedFile(TConstArrayView<uint8> Raw, EULUECompressionCodec Codec, uint32 BlockSize, TArray<uint8>& OutEncoded)
+    {
+        const FName Format = GetCompressionFormat(Codec);
+        if (Format.IsNone() || BlockSize == 0 || Raw.Num() == 0)
+        {
+            return false;
+        }
+
+        const int32 NumBlocks = FMath::DivideAndRoundUp(Raw.Num(), static_cast<int32>(BlockSize));
+        TArray<TArray<uint8>> Blocks;
+        Blocks.SetNum(NumBlocks);
+        std::atomic<bool> bFailed{ false };
+
+        ParallelFor(NumBlocks, [&](int32 Block)
+        {
+            const int64 Offset = static_cast<int64>(Block) * BlockSize;
+            const int32 RawSize = static_cast<int32>(FMath::Min<int64>(BlockSize, Raw.Num() - Offset));
+            int32 CompressedSize = FCompression::CompressMemoryBound(Format, RawSize);
+            Blocks[Block].SetNumUninitialized(CompressedSize);
+            if (!FCompression::CompressMemory(Format, Blocks[Block].GetData(), CompressedSize, Raw.GetData() + Offset, RawSize))
+            {
+                bFailed = true;
+                return;
+            }
+            Blocks[Block].SetNum(CompressedSize);
+        });
+
+        if (bFailed)
+        {
+            return false;
+        }
+
+        FULUECompressedFileHeader Header;
+        Header.Magic = CompressedFile::Magic;
+        Header.Codec = Codec;
+        Header.BlockSize = BlockSize;
+        Header.NumBlocks = NumBlocks;
+        Header.UncompressedSize = Raw.Num();
+
+        OutEncoded.Reset();
+        OutEncoded.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+        for (const TArray<uint8>& Block : Blocks)
+        {
+            const uint32 BlockBytes = Block.Num();
+            OutEncoded.Append(reinterpret_cast<const uint8*>(&BlockBytes), sizeof(BlockBytes));
+        }
+        for (const TArray<uint8>& Block : Blocks)
+        {
+            OutEncoded.Append(Block);
+        }
+        return true;
+    }
+
+    bool DecodeCompressedFile(TConstArrayView<uint8> Encoded, TArray<uint8>& OutDecoded)
+    {
+        ULUE_SCOPE_CYCLE_COUNTER(Decompress);
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+
+        FULUECompressedFileHeader Header;
+        if (Encoded.Num() < static_cast<int32>(sizeof(Header)))
+        {
+            return false;
+        }
+        FMemory::Memcpy(&Header, Encoded.GetData(), sizeof(Header));
+
+        const FName Format = GetCompressionFormat(Header.Codec);
+        if (Header.Magic != CompressedFile::Magic || Format.IsNone() || Header.BlockSize == 0
+            || Header.UncompressedSize == 0 || Header.UncompressedSize > MAX_int32
+            || Header.NumBlocks != FMath::DivideAndRoundUp<uint64>(Header.UncompressedSize, Header.BlockSize))
+        {
+            return false;
+        }
+
+        const int64 TableOffset = sizeof(Header);
+        const int64 TableBytes = static_cast<int64>(Header.NumBlocks) * sizeof(uint32);
+        if (TableBytes > Encoded.Num() - TableOffset)
+        {
+            return false;
+        }
+
+        // Block sizes -> offsets; also proves every block lies inside the file before any decoding starts.
+        TArray<int64> BlockOffsets;
+        BlockOffsets.SetNumUninitialized(Header.NumBlocks + 1);
+        BlockOffsets[0] = TableOffset + TableBytes;
+        for (uint32 Block = 0; Block < Header.NumBlocks; ++Block)
+        {
+            uint32 BlockBytes = 0;
+            FMemory::Memcpy(&BlockBytes, Encoded.GetData() + TableOffset + Block * sizeof(uint32), sizeof(uint32));
+            BlockOffsets[Block + 1] = BlockOffsets[Block] + BlockBytes;
+        }
+        if (BlockOffsets.Last() > Encoded.Num())
+        {
+            return false;
+        }
+
+        OutDecoded.SetNumUninitialized(static_cast<int32>(Header.UncompressedSize));
+        std::atomic<bool> bFailed{ false };
+
+        ParallelFor(static_cast<int32>(Header.NumBlocks), [&](int32 Block)
+        {
+            const int64 DecodedOffset = static_cast<int64>(Block) * Header.BlockSize;
+            const int32 DecodedSize = static_cast<int32>(FMath::Min<uint64>(Header.BlockSize, Header.UncompressedSize - DecodedOffset));
+            const int32 CompressedSize = static_cast<int32>(BlockOffsets[Block + 1] - BlockOffsets[Block]);
+            if (!FCompression::UncompressMemory(Format, OutDecoded.GetData() + DecodedOffset, DecodedSize, Encoded.GetData() + BlockOffsets[Block], CompressedSize))
+            {
+                bFailed = true;
+            }
+        }, Header.NumBlocks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+        if (bFailed)
+        {
+            OutDecoded.Reset();
+            return false;
+        }
+
+        GDecodedFiles.fetch_add(1, std::memory_order_relaxed);
+        GCompressedBytes.fetch_add(Encoded.Num(), std::memory_order_relaxed);
+        GDecodedBytes.fetch_add(OutDecoded.Num(), std::memory_order_relaxed);
+        GDecodeCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+        return true;
+    }
+
+    FULUEDecompressionReport GetDecompressionReport()
+    {
+        FULUEDecompressionReport Report;
+        Report.Files = GDecodedFiles.load(std::memory_order_relaxed);
+        Report.CompressedBytes = GCompressedBytes.load(std::memory_order_relaxed);
+        Report.DecodedBytes = GDecodedBytes.load(std::memory_order_relaxed);
+        Report.DecodeSeconds = FPlatformTime::ToSeconds64(GDecodeCycles.load(std::memory_order_relaxed));
+        return Report;
+    }
+}
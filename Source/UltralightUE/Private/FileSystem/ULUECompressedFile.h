@@ -0,0 +1,63 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace ultralightue
+{
+    /// @brief Precompressed sibling files ("app.js" -> "app.js.ulz"), written at cook time by -run=UltralightCompress.
+    ///
+    /// Layout (little endian):
+    ///   FULUECompressedFileHeader
+    ///   uint32 CompressedBlockSizes[NumBlocks]
+    ///   blocks, back to back; block i decodes to BlockSize bytes (the last one to the remainder)
+    ///
+    /// Blocks are independent, so large files decode in parallel across worker threads.
+    namespace CompressedFile
+    {
+        constexpr uint32 Magic = 0x315A4C55; // "ULZ1"
+        constexpr const TCHAR* Extension = TEXT(".ulz");
+        constexpr uint32 DefaultBlockSize = 256 * 1024;
+    }
+
+    enum class EULUECompressionCodec : uint8
+    {
+        Oodle = 1,
+        Zlib = 2,
+        LZ4 = 3,
+    };
+
+    struct FULUECompressedFileHeader
+    {
+        uint32 Magic = 0;
+        EULUECompressionCodec Codec = EULUECompressionCodec::Oodle;
+        uint8 Reserved[3] = {};
+        uint32 BlockSize = 0;
+        uint32 NumBlocks = 0;
+        uint64 UncompressedSize = 0;
+    };
+    static_assert(sizeof(FULUECompressedFileHeader) == 24, "Compressed file header layout is part of the file format");
+
+    /// Maps a codec to its FCompression format name, or NAME_None if unknown.
+    FName GetCompressionFormat(EULUECompressionCodec Codec);
+
+    /// @brief Compresses Raw into the sibling format. Returns false if the codec fails.
+    bool EncodeCompressedFile(TConstArrayView<uint8> Raw, EULUECompressionCodec Codec, uint32 BlockSize, TArray<uint8>& OutEncoded);
+
+    /// @brief Decodes a sibling file, spreading blocks over worker threads. Validates every size and offset.
+    bool DecodeCompressedFile(TConstArrayView<uint8> Encoded, TArray<uint8>& OutDecoded);
+
+    /// @brief Totals over every runtime decode, for the Ultralight.LogFileCompression report.
+    struct FULUEDecompressionReport
+    {
+        int64 Files = 0;
+        int64 CompressedBytes = 0;
+        int64 DecodedBytes = 0;
+        double DecodeSeconds = 0.0;
+    };
+    FULUEDecompressionReport GetDecompressionReport();
+}
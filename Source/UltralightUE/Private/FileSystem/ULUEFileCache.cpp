@@ -0,0 +1,173 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#include "FileSystem/ULUEFileCache.h"
+#include "Misc/ScopeLock.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "ULUEStats.h"
+
+namespace ultralightue
+{
+    namespace
+    {
+        /// Upper bound on entry count; the byte budget is what normally limits the cache.
+        constexpr int32 MaxCachedFiles = 4096;
+
+        void DestroyBlobBuffer(void* user_data, void* /*data*/)
+        {
+            delete static_cast<FULUEFileBlobPtr*>(user_data);
+        }
+    }
+
+    FULUEHeapFileBlob::FULUEHeapFileBlob(TArray<uint8>&& InStorage)
+        : Storage(MoveTemp(InStorage))
+    {
+        Data = Storage.GetData();
+        Size = Storage.Num();
+        TrackMemory(EULUEMemoryCounter::FileBuffers, Storage.GetAllocatedSize());
+    }
+
+    FULUEHeapFileBlob::~FULUEHeapFileBlob()
+    {
+        TrackMemory(EULUEMemoryCounter::FileBuffers, -static_cast<int64>(Storage.GetAllocatedSize()));
+    }
+
+    FULUEFileBlobPtr FULUEMappedFileBlob::Map(const FString& Path)
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        FOpenMappedResult Opened = PlatformFile.OpenMappedEx(*Path);
+        if (Opened.HasError())
+        {
+            return nullptr;
+        }
+
+        TUniquePtr<IMappedFileHandle> Handle = Opened.StealValue();
+        const int64 FileSize = Handle.IsValid() ? Handle->GetFileSize() : 0;
+        if (FileSize <= 0)
+        {
+            return nullptr;
+        }
+
+        TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, FileSize));
+        if (!Region.IsValid() || !Region->GetMappedPtr())
+        {
+            return nullptr;
+        }
+
+        return MakeShared<FULUEMappedFileBlob, ESPMode::ThreadSafe>(MoveTemp(Handle), MoveTemp(Region));
+    }
+
+    FULUEMappedFileBlob::FULUEMappedFileBlob(TUniquePtr<IMappedFileHandle>&& InHandle, TUniquePtr<IMappedFileRegion>&& InRegion)
+        : Handle(MoveTemp(InHandle))
+        , Region(MoveTemp(InRegion))
+    {
+        Data = Region->GetMappedPtr();
+        Size = Region->GetMappedSize();
+        TrackMemory(EULUEMemoryCounter::MappedFiles, Size);
+    }
+
+    FULUEMappedFileBlob::~FULUEMappedFileBlob()
+    {
+        TrackMemory(EULUEMemoryCounter::MappedFiles, -Size);
+        // The region must be unmapped before its file handle closes.
+        Region.Reset();
+        Handle.Reset();
+    }
+
+    ultralight::RefPtr<ultralight::Buffer> MakeBufferFromBlob(const FULUEFileBlobPtr& Blob)
+    {
+        if (!Blob.IsValid())
+        {
+            return nullptr;
+        }
+        if (Blob->GetSize() == 0)
+        {
+            return ultralight::Buffer::CreateFromCopy("", 0);
+        }
+
+        // Ultralight never writes through the pointer; Buffer just takes a non-const void*.
+        FULUEFileBlobPtr* Reference = new FULUEFileBlobPtr(Blob);
+        return ultralight::Buffer::Create(const_cast<uint8*>(Blob->GetData()), static_cast<size_t>(Blob->GetSize()), Reference, &DestroyBlobBuffer);
+    }
+
+    FULUEFileCache::FULUEFileCache(int64 InBudgetBytes)
+        : Entries(MaxCachedFiles)
+        , BudgetBytes(InBudgetBytes)
+    {
+    }
+
+    FULUEFileBlobPtr FULUEFileCache::Find(const FString& Path)
+    {
+        FScopeLock ScopeLock(&Lock);
+        const FULUEFileBlobPtr* Found = Entries.FindAndTouch(Path);
+        return Found ? *Found : nullptr;
+    }
+
+    void FULUEFileCache::Add(const FString& Path, const FULUEFileBlobPtr& Blob)
+    {
+        if (!Blob.IsValid())
+        {
+            return;
+        }
+
+        FScopeLock ScopeLock(&Lock);
+        const int64 BlobBytes = Blob->GetResidentBytes();
+        if (BlobBytes > BudgetBytes / 4)
+        {
+            return;
+        }
+
+        if (const FULUEFileBlobPtr* Existing = Entries.Find(Path))
+        {
+            CachedBytes -= (*Existing)->GetResidentBytes();
+            Entries.Remove(Path);
+        }
+
+        EvictToBudget(BlobBytes);
+        Entries.Add(Path, Blob);
+        CachedBytes += BlobBytes;
+    }
+
+    void FULUEFileCache::Invalidate(const FString& Path)
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (const FULUEFileBlobPtr* Existing = Entries.Find(Path))
+        {
+            CachedBytes -= (*Existing)->GetResidentBytes();
+            Entries.Remove(Path);
+        }
+    }
+
+    void FULUEFileCache::Empty()
+    {
+        FScopeLock ScopeLock(&Lock);
+        Entries.Empty(MaxCachedFiles);
+        CachedBytes = 0;
+    }
+
+    void FULUEFileCache::SetBudget(int64 InBudgetBytes)
+    {
+        FScopeLock ScopeLock(&Lock);
+        BudgetBytes = InBudgetBytes;
+        EvictToBudget(0);
+    }
+
+    int64 FULUEFileCache::GetCachedBytes() const
+    {
+        FScopeLock ScopeLock(&Lock);
+        return CachedBytes;
+    }
+
+    void FULUEFileCache::EvictToBudget(int64 IncomingBytes)
+    {
+        // TLruCache would silently drop its oldest entry when full; evict ourselves to keep the byte count right.
+        while (Entries.Num() > 0 && (CachedBytes + IncomingBytes > BudgetBytes || Entries.Num() >= Entries.Max()))
+        {
+            const FULUEFileBlobPtr Evicted = Entries.RemoveLeastRecent();
+            CachedBytes -= Evicted.IsValid() ? Evicted->GetResidentBytes() : 0;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+#include "ULUEUltralightIncludes.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace ultralightue
+{
+    /// @brief Immutable file contents, shared between the cache and every Buffer handed to Ultralight.
+    class FULUEFileBlob
+    {
+    public:
+        virtual ~FULUEFileBlob() = default;
+
+        const uint8* GetData() const { return Data; }
+        int64 GetSize() const { return Size; }
+
+        /// Heap bytes this blob pins; what the cache budget is charged.
+        virtual int64 GetResidentBytes() const = 0;
+
+    protected:
+        const uint8* Data = nullptr;
+        int64 Size = 0;
+    };
+
+    using FULUEFileBlobPtr = TSharedPtr<const FULUEFileBlob, ESPMode::ThreadSafe>;
+
+    /// @brief File read into memory. Counted under the file buffer memory stat while alive.
+    class FULUEHeapFileBlob final : public FULUEFileBlob
+    {
+    public:
+        explicit FULUEHeapFileBlob(TArray<uint8>&& InStorage);
+        virtual ~FULUEHeapFileBlob() override;
+
+        virtual int64 GetResidentBytes() const override { return Storage.GetAllocatedSize(); }
+
+    private:
+        TArray<uint8> Storage;
+    };
+
+    /// @brief Read-only mapping of a whole file. Pages are faulted in on first access and shared with the
+    /// OS page cache; the mapping is released with the last reference. Counted under the mapped file stat.
+    class FULUEMappedFileBlob final : public FULUEFileBlob
+    {
+    public:
+        /// Maps Path, or returns null if the platform can't map it (caller falls back to reading).
+        static FULUEFileBlobPtr Map(const FString& Path);
+
+        FULUEMappedFileBlob(TUniquePtr<IMappedFileHandle>&& InHandle, TUniquePtr<IMappedFileRegion>&& InRegion);
+        virtual ~FULUEMappedFileBlob() override;
+
+        virtual int64 GetResidentBytes() const override { return 0; }
+
+    private:
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+    };
+
+    /// @brief Wraps a blob in an ultralight::Buffer without copying. The Buffer holds a reference to the
+    /// blob, so eviction from the cache never invalidates data Ultralight is still reading.
+    ultralight::RefPtr<ultralight::Buffer> MakeBufferFromBlob(const FULUEFileBlobPtr& Blob);
+
+    /// @brief Byte-bounded LRU cache of file contents, keyed by resolved path. Thread-safe.
+    class FULUEFileCache
+    {
+    public:
+        explicit FULUEFileCache(int64 InBudgetBytes);
+
+        /// Returns the cached blob and marks it most recently used, or null on a miss.
+        FULUEFileBlobPtr Find(const FString& Path);
+
+        /// Caches Blob under Path, evicting least recently used entries to stay within budget.
+        /// Blobs whose resident size exceeds a quarter of the budget are not cached.
+        void Add(const FString& Path, const FULUEFileBlobPtr& Blob);
+
+        void Invalidate(const FString& Path);
+        void Empty();
+
+        void SetBudget(int64 InBudgetBytes);
+        int64 GetCachedBytes() const;
+
+    private:
+        /// Lock must be held.
+        void EvictToBudget(int64 IncomingBytes);
+
+        mutable FCriticalSection Lock;
+        TLruCache<FString, FULUEFileBlobPtr> Entries;
+        int64 BudgetBytes = 0;
+        int64 CachedBytes = 0;
+    };
+}
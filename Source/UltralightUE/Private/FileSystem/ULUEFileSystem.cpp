@@ -5,27 +5,116 @@
  */
 
 #include "FileSystem/ULUEFileSystem.h"
+#include "FileSystem/ULUECompressedFile.h"
 #include "HAL/PlatformFileManager.h"
 #include "HAL/FileManager.h"
-#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "ULUEStats.h"
+#include "ULUETrace.h"
 
 namespace ultralightue
 {
+    namespace
+    {
+        TAutoConsoleVariable<int32> CVarFileCacheSizeMB(
+            TEXT("Ultralight.FileCacheSizeMB"),
+            64,
+            TEXT("Size of the in-memory cache of UI file contents (HTML, CSS, JS, fonts, images) in MB. 0 disables caching."),
+            ECVF_Default);
+
+        TAutoConsoleVariable<int32> CVarMappedFileThresholdKB(
+            TEXT("Ultralight.MappedFileThresholdKB"),
+            1024,
+            TEXT("Files at least this large (in KB) are memory-mapped instead of read into memory. 0 disables mapping."),
+            ECVF_Default);
+
+        TAutoConsoleVariable<bool> CVarMapResourceFiles(
+            TEXT("Ultralight.MapResourceFiles"),
+            true,
+            TEXT("Serve Ultralight's own resources (ICU data, certificates) as shared read-only memory mappings, whatever their size."),
+            ECVF_Default);
+
+        TAutoConsoleVariable<bool> CVarUsePrecompressedFiles(
+            TEXT("Ultralight.UsePrecompressedFiles"),
+            true,
+            TEXT("In packaged builds, serve <file>.ulz siblings written by -run=UltralightCompress in place of <file>."),
+            ECVF_Default);
+
+        TAutoConsoleVariable<bool> CVarReadahead(
+            TEXT("Ultralight.Readahead"),
+            true,
+            TEXT("Record the files each file:/// page opens and prefetch them in parallel the next time the page loads."),
+            ECVF_Default);
+
+        TAutoConsoleVariable<float> CVarMissingFileCacheSeconds(
+            TEXT("Ultralight.MissingFileCacheSeconds"),
+            2.0f,
+            TEXT("How long a file found missing is reported missing without checking again (the disk for loose files, the package listing for packaged ones)."),
+            ECVF_Default);
+
+        int64 GetFileCacheBudget()
+        {
+            return static_cast<int64>(FMath::Max(CVarFileCacheSizeMB.GetValueOnAnyThread(), 0)) * 1024 * 1024;
+        }
+
+        int64 GetMappedFileThreshold()
+        {
+            const int32 ThresholdKB = CVarMappedFileThresholdKB.GetValueOnAnyThread();
+            return ThresholdKB > 0 ? static_cast<int64>(ThresholdKB) * 1024 : MAX_int64;
+        }
+
+        /// Ultralight strings are UTF-8 internally, so this is a view, not a conversion.
+        FUtf8StringView ToUtf8View(const ultralight::String& Path)
+        {
+            const ultralight::String8& Utf8 = Path.utf8();
+            return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.data()), static_cast<int32>(Utf8.length()));
+        }
+    }
+
     ULUEFileSystem::ULUEFileSystem()
         : BaseDirectory(FPaths::ProjectContentDir())
         , ResourceDirectory(BaseDirectory)
         , AccessPattern(FSAccess::FSA_Native)
+        , ContentCache(GetFileCacheBudget())
     {
+        UpdateResourcePrefix();
     }
 
     ULUEFileSystem::~ULUEFileSystem()
     {
+        if (PakMountedHandle.IsValid())
+        {
+            FCoreDelegates::GetOnPakFileMounted2().Remove(PakMountedHandle);
+        }
+
+        // Prefetch tasks reference this; let them finish before the members go away.
+        TArray<UE::Tasks::TTask<FULUEFileBlobPtr>> InFlight;
+        {
+            FScopeLock ScopeLock(&PendingReadsLock);
+            PendingReads.GenerateValueArray(InFlight);
+        }
+        UE::Tasks::Wait(InFlight);
+
+        Readahead.Save();
     }
 
     void ULUEFileSystem::SetFSAccess(FSAccess InAccessPattern)
     {
         AccessPattern = InAccessPattern;
+
+        if (IsPackaged() && !PakMountedHandle.IsValid())
+        {
+            PakMountedHandle = FCoreDelegates::GetOnPakFileMounted2().AddRaw(this, &ULUEFileSystem::OnPakFileMounted);
+        }
+        bListingDirty = true;
+    }
+
+    FSAccess ULUEFileSystem::GetDefaultFSAccess()
+    {
+        return FPlatformProperties::RequiresCookedData() ? FSAccess::FSA_Package : FSAccess::FSA_Native;
     }
 
     void ULUEFileSystem::SetBaseDirectory(const FString& InBaseDirectory)
@@ -35,18 +124,198 @@ namespace ultralightue
         {
             ResourceDirectory = BaseDirectory;
         }
+        UpdateResourcePrefix();
+        PathCache.Empty();
+        bListingDirty = true;
     }
 
     void ULUEFileSystem::SetResourceDirectory(const FString& InResourceDirectory)
     {
         ResourceDirectory = InResourceDirectory;
+        UpdateResourcePrefix();
+        PathCache.Empty();
+        bListingDirty = true;
+    }
+
+    void ULUEFileSystem::UpdateResourcePrefix()
+    {
+        ResourcePrefix = MapPath(FStringView(TEXT("resources/")));
+
+        FScopeLock ScopeLock(&ResourceMappingsLock);
+        ResourceMappings.Empty();
+    }
+
+    FULUEFileBlobPtr ULUEFileSystem::MapResourceFile(const FString& UEPath)
+    {
+        if (!CVarMapResourceFiles.GetValueOnAnyThread() || !UEPath.StartsWith(ResourcePrefix))
+        {
+            return nullptr;
+        }
+
+        {
+            FScopeLock ScopeLock(&ResourceMappingsLock);
+            if (const FULUEFileBlobPtr* Found = ResourceMappings.Find(UEPath))
+            {
+                return *Found;
+            }
+        }
+
+        // Resources ship as loose, never-edited files, so unlike content mappings these stay open for reuse.
+        const FULUEFileBlobPtr Mapped = FULUEMappedFileBlob::Map(UEPath);
+        if (Mapped.IsValid())
+        {
+            FScopeLock ScopeLock(&ResourceMappingsLock);
+            return ResourceMappings.FindOrAdd(UEPath, Mapped);
+        }
+        return nullptr;
+    }
+
+    bool ULUEFileSystem::MountBundle(const FString& BundlePath)
+    {
+        ContentBundle = FULUEBundle::Open(BundlePath);
+        if (ContentBundle.IsValid())
+        {
+            UE_LOG(LogTemp, Log, TEXT("ULUEFileSystem - Serving %d UI files from bundle %s"), ContentBundle->Num(), *BundlePath);
+        }
+        return ContentBundle.IsValid();
+    }
+
+    void ULUEFileSystem::TrimCaches()
+    {
+        ContentCache.Empty();
+        PathCache.Empty();
+    }
+
+    void ULUEFileSystem::LoadReadaheadManifest(const FString& SavePath, const FString& SeedPath)
+    {
+        Readahead.Load(SavePath, SeedPath);
+    }
+
+    bool ULUEFileSystem::BeginPageLoad(const FString& URL)
+    {
+        // Only local pages have dependencies we can read ahead.
+        if (!CVarReadahead.GetValueOnAnyThread() || !URL.StartsWith(TEXT("file:///"), ESearchCase::IgnoreCase))
+        {
+            return false;
+        }
+
+        const FString Page = FULUEReadaheadManifest::NormalizePath(URL);
+        const TArray<FString> Dependencies = Readahead.GetDependencies(Page);
+        if (Dependencies.Num() > 0)
+        {
+            ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight Readahead %s (%d files)"), *Page, Dependencies.Num()));
+            Prefetch(Dependencies, AIOP_Normal);
+        }
+
+        Readahead.BeginRecording(Page);
+        return true;
+    }
+
+    void ULUEFileSystem::EndPageLoad(const FString& URL, bool bCommit)
+    {
+        Readahead.EndRecording(FULUEReadaheadManifest::NormalizePath(URL), bCommit);
+        if (bCommit)
+        {
+            Readahead.Save();
+        }
+    }
+
+    void ULUEFileSystem::InvalidateFile(const FString& UEPath)
+    {
+        {
+            FScopeLock ScopeLock(&ResourceMappingsLock);
+            ResourceMappings.Remove(UEPath);
+        }
+        ContentCache.Invalidate(UEPath);
+        PathCache.Invalidate(UEPath);
+        bListingDirty = true;
+    }
+
+    FString ULUEFileSystem::GetUEPath(FStringView UltralightPath) const
+    {
+        return MapPath(UltralightPath);
+    }
+
+    TArray<FString> ULUEFileSystem::GetPageDependencies(const FString& URL) const
+    {
+        return Readahead.GetDependencies(FULUEReadaheadManifest::NormalizePath(URL));
+    }
+
+    void ULUEFileSystem::InvalidateAllFiles()
+    {
+        ContentCache.Empty();
+        PathCache.ResetStates();
+        bListingDirty = true;
+    }
+
+    void ULUEFileSystem::Prefetch(TConstArrayView<FString> Paths, EAsyncIOPriorityAndFlags Priority)
+    {
+        const UE::Tasks::ETaskPriority TaskPriority = (Priority & AIOP_PRIORITY_MASK) >= AIOP_High
+            ? UE::Tasks::ETaskPriority::High
+            : UE::Tasks::ETaskPriority::BackgroundNormal;
+
+        for (const FString& Path : Paths)
+        {
+            FString UEPath = MapPath(Path);
+            if (ContentCache.Find(UEPath).IsValid() || IsInBundle(UEPath) || (IsPackaged() && !IsPackagedFile(UEPath)))
+            {
+                continue;
+            }
+
+            FScopeLock ScopeLock(&PendingReadsLock);
+            if (PendingReads.Contains(UEPath))
+            {
+                continue;
+            }
+
+            PendingReads.Add(UEPath, UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, UEPath, Priority]()
+            {
+                FULUEFileBlobPtr Blob;
+                if (IsPackaged())
+                {
+                    Blob = ReadPackagedFile(UEPath, Priority);
+                }
+                else
+                {
+                    Blob = ReadNativeFile(UEPath);
+                }
+
+                // Cached before the pending entry goes away, so OpenFile never misses both.
+                FScopeLock RemoveLock(&PendingReadsLock);
+                PendingReads.Remove(UEPath);
+                return Blob;
+            }, TaskPriority));
+        }
     }
 
     bool ULUEFileSystem::FileExists(const ultralight::String& file_path)
     {
-        FString UEPath = MapPath(file_path);
-        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-        return PlatformFile.FileExists(*UEPath);
+        // Repeat probes (favicons, fallback fonts, resources) are answered without allocating or touching the disk.
+        const FUtf8StringView Source = ToUtf8View(file_path);
+        EULUEPathState State = EULUEPathState::Unknown;
+        if (FindPathState(Source, State) && State != EULUEPathState::Unknown)
+        {
+            return State == EULUEPathState::Exists;
+        }
+
+        const FString UEPath = ResolvePath(Source, State);
+        bool bExists = false;
+        if (IsInBundle(UEPath))
+        {
+            bExists = true;
+        }
+        else if (IsPackaged())
+        {
+            bExists = IsPackagedFile(UEPath);
+        }
+        else
+        {
+            IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+            bExists = PlatformFile.FileExists(*UEPath);
+        }
+
+        PathCache.SetState(Source, bExists ? EULUEPathState::Exists : EULUEPathState::Missing);
+        return bExists;
     }
 
     ultralight::String ULUEFileSystem::GetFileMimeType(const ultralight::String& file_path)
@@ -64,53 +333,364 @@ namespace ultralightue
 
     ultralight::RefPtr<ultralight::Buffer> ULUEFileSystem::OpenFile(const ultralight::String& file_path)
     {
-        FString UEPath = MapPath(file_path);
+        ULUE_SCOPE_CYCLE_COUNTER(OpenFile);
+
+        const FUtf8StringView Source = ToUtf8View(file_path);
+        EULUEPathState State = EULUEPathState::Unknown;
+        const FString UEPath = ResolvePath(Source, State);
+        ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight OpenFile %s"), *UEPath));
+
+        if (State == EULUEPathState::Missing)
+        {
+            return nullptr;
+        }
+
+        const ultralight::RefPtr<ultralight::Buffer> Buffer = OpenResolvedFile(UEPath);
+        PathCache.SetState(Source, Buffer ? EULUEPathState::Exists : EULUEPathState::Missing);
+        if (Buffer)
+        {
+            Readahead.RecordAccess(Source);
+        }
+        return Buffer;
+    }
+
+    ultralight::RefPtr<ultralight::Buffer> ULUEFileSystem::OpenResolvedFile(const FString& UEPath)
+    {
+        // ICU data and certificates: mapped once, paged in lazily and shared with every process mapping them.
+        if (const FULUEFileBlobPtr Resource = MapResourceFile(UEPath))
+        {
+            return MakeBufferFromBlob(Resource);
+        }
+
+        // Cache hit: no disk access and no copy, the Buffer points straight at the cached bytes.
+        if (FULUEFileBlobPtr Cached = ContentCache.Find(UEPath))
+        {
+            INC_DWORD_STAT(STAT_UltralightFileCacheHits);
+            return MakeBufferFromBlob(Cached);
+        }
+        INC_DWORD_STAT(STAT_UltralightFileCacheMisses);
+
+        // Join a prefetch that is already reading this file instead of issuing a second read.
+        UE::Tasks::TTask<FULUEFileBlobPtr> Pending;
+        {
+            FScopeLock ScopeLock(&PendingReadsLock);
+            if (const UE::Tasks::TTask<FULUEFileBlobPtr>* Found = PendingReads.Find(UEPath))
+            {
+                Pending = *Found;
+            }
+        }
+        if (Pending.IsValid())
+        {
+            return MakeBufferFromBlob(Pending.GetResult());
+        }
+
+        // Uncompressed bundle entries are slices of the mapped bundle; only decoded entries take cache space.
+        if (const FULUEFileBlobPtr Bundled = FindInBundle(UEPath))
+        {
+            AddToCache(UEPath, Bundled);
+            return MakeBufferFromBlob(Bundled);
+        }
+
+        if (IsPackaged())
+        {
+            if (!IsPackagedFile(UEPath))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ULUEFileSystem::OpenFile - File not found in packaged content: %s"), *UEPath);
+                return nullptr;
+            }
+
+            const FULUEFileBlobPtr Blob = ReadPackagedFile(UEPath, AIOP_High);
+            if (!Blob.IsValid())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ULUEFileSystem::OpenFile - Failed to read packaged file: %s"), *UEPath);
+            }
+            return MakeBufferFromBlob(Blob);
+        }
+
+        const FULUEFileBlobPtr Blob = ReadNativeFile(UEPath);
+        if (!Blob.IsValid())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ULUEFileSystem::OpenFile - File not found, empty or unreadable: %s"), *UEPath);
+        }
+        return MakeBufferFromBlob(Blob);
+    }
+
+    FULUEFileBlobPtr ULUEFileSystem::ReadNativeFile(const FString& UEPath)
+    {
+        // One open; a missing file simply fails here instead of costing a separate exists stat.
         IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*UEPath));
+        if (!FileHandle.IsValid())
+        {
+            return nullptr;
+        }
+
+        const int64 FileSize = FileHandle->Size();
+        if (FileSize <= 0)
+        {
+            return nullptr;
+        }
+
+        // Large assets (images, fonts, bundles) are mapped rather than copied into the heap. Mappings are not
+        // cached: they cost no heap, the OS page cache already keeps hot pages, and an open mapping would lock
+        // the file against edits on some platforms. Falls back to a read where mapping isn't supported.
+        if (FileSize >= GetMappedFileThreshold())
+        {
+            if (const FULUEFileBlobPtr Mapped = FULUEMappedFileBlob::Map(UEPath))
+            {
+                return Mapped;
+            }
+        }
+
+        TArray<uint8> FileData;
+        FileData.SetNumUninitialized(FileSize);
+        if (!FileHandle->Read(FileData.GetData(), FileSize))
+        {
+            return nullptr;
+        }
+        FileHandle.Reset();
 
-        // Check if file exists
-        if (!PlatformFile.FileExists(*UEPath))
+        const FULUEFileBlobPtr Blob = MakeShared<FULUEHeapFileBlob, ESPMode::ThreadSafe>(MoveTemp(FileData));
+        AddToCache(UEPath, Blob);
+        return Blob;
+    }
+
+    FULUEFileBlobPtr ULUEFileSystem::ReadPackagedFile(const FString& UEPath, EAsyncIOPriorityAndFlags Priority)
+    {
+        // A precompressed sibling wins over the raw file; a cook may stage only the sibling.
+        const FString SiblingPath = UEPath + CompressedFile::Extension;
+        if (CVarUsePrecompressedFiles.GetValueOnAnyThread() && IsInPackageListing(SiblingPath))
+        {
+            if (const FULUEFileBlobPtr Encoded = ReadPackagedBlob(SiblingPath, Priority))
+            {
+                TArray<uint8> Decoded;
+                if (DecodeCompressedFile(TConstArrayView<uint8>(Encoded->GetData(), static_cast<int32>(Encoded->GetSize())), Decoded))
+                {
+                    const FULUEFileBlobPtr Blob = MakeShared<FULUEHeapFileBlob, ESPMode::ThreadSafe>(MoveTemp(Decoded));
+                    AddToCache(UEPath, Blob);
+                    return Blob;
+                }
+                UE_LOG(LogTemp, Warning, TEXT("ULUEFileSystem - Corrupt precompressed file %s; falling back to the raw file"), *SiblingPath);
+            }
+        }
+
+        const FULUEFileBlobPtr Blob = ReadPackagedBlob(UEPath, Priority);
+        AddToCache(UEPath, Blob);
+        return Blob;
+    }
+
+    FULUEFileBlobPtr ULUEFileSystem::ReadPackagedBlob(const FString& UEPath, EAsyncIOPriorityAndFlags Priority)
+    {
+        ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight ReadPackagedFile %s"), *UEPath));
+
+        // Requests must be destroyed before their handle; declaration order takes care of that.
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        TUniquePtr<IAsyncReadFileHandle> Handle(PlatformFile.OpenAsyncRead(*UEPath));
+        if (!Handle.IsValid())
         {
-            UE_LOG(LogTemp, Warning, TEXT("ULUEFileSystem::OpenFile - File not found: %s"), *UEPath);
             return nullptr;
         }
 
-        // Get file size
-        int64 FileSize = PlatformFile.FileSize(*UEPath);
+        TUniquePtr<IAsyncReadRequest> SizeRequest(Handle->SizeRequest());
+        if (!SizeRequest.IsValid())
+        {
+            return nullptr;
+        }
+        SizeRequest->WaitCompletion();
+        const int64 FileSize = SizeRequest->GetSizeResults();
         if (FileSize <= 0)
         {
-            UE_LOG(LogTemp, Warning, TEXT("ULUEFileSystem::OpenFile - File is empty or size error: %s"), *UEPath);
             return nullptr;
         }
 
-        // Read the entire file into memory
+        // Uncompressed pak entries and loose staged files can still be mapped.
+        if (FileSize >= GetMappedFileThreshold())
+        {
+            if (const FULUEFileBlobPtr Mapped = FULUEMappedFileBlob::Map(UEPath))
+            {
+                return Mapped;
+            }
+        }
+
         TArray<uint8> FileData;
-        if (!FFileHelper::LoadFileToArray(FileData, *UEPath))
+        FileData.SetNumUninitialized(FileSize);
+        TUniquePtr<IAsyncReadRequest> ReadRequest(Handle->ReadRequest(0, FileSize, Priority, nullptr, FileData.GetData()));
+        if (!ReadRequest.IsValid())
+        {
+            return nullptr;
+        }
+        ReadRequest->WaitCompletion();
+        if (ReadRequest->WasCanceled() || !ReadRequest->GetReadResults())
         {
-            UE_LOG(LogTemp, Error, TEXT("ULUEFileSystem::OpenFile - Failed to read file: %s"), *UEPath);
             return nullptr;
         }
 
-        // Create a Buffer from the file data (makes a copy)
-        return ultralight::Buffer::CreateFromCopy(FileData.GetData(), FileData.Num());
+        return MakeShared<FULUEHeapFileBlob, ESPMode::ThreadSafe>(MoveTemp(FileData));
     }
 
-    FString ULUEFileSystem::MapPath(const ultralight::String& path) const
+    bool ULUEFileSystem::GetBundleRelativePath(const FString& UEPath, FStringView& OutRelativePath) const
+    {
+        if (!ContentBundle.IsValid() || !UEPath.StartsWith(BaseDirectory))
+        {
+            return false;
+        }
+        OutRelativePath = FStringView(UEPath).RightChop(BaseDirectory.Len());
+        return true;
+    }
+
+    FULUEFileBlobPtr ULUEFileSystem::FindInBundle(const FString& UEPath) const
+    {
+        FStringView RelativePath;
+        return GetBundleRelativePath(UEPath, RelativePath) ? ContentBundle->Find(RelativePath) : nullptr;
+    }
+
+    bool ULUEFileSystem::IsInBundle(const FString& UEPath) const
+    {
+        FStringView RelativePath;
+        return GetBundleRelativePath(UEPath, RelativePath) && ContentBundle->Contains(RelativePath);
+    }
+
+    void ULUEFileSystem::AddToCache(const FString& UEPath, const FULUEFileBlobPtr& Blob)
+    {
+        if (Blob.IsValid() && Blob->GetResidentBytes() > 0)
+        {
+            ContentCache.SetBudget(GetFileCacheBudget());
+            ContentCache.Add(UEPath, Blob);
+        }
+    }
+
+    bool ULUEFileSystem::IsInPackageListing(const FString& UEPath)
+    {
+        if (bListingDirty.load(std::memory_order_acquire))
+        {
+            // Readers wait here while the listing is rebuilt rather than reporting staged files as missing.
+            FWriteScopeLock ScopeLock(ListingLock);
+            if (bListingDirty.exchange(false))
+            {
+                RebuildPackageListing();
+            }
+        }
+
+        FReadScopeLock ScopeLock(ListingLock);
+        return PackageListing.Contains(UEPath);
+    }
+
+    bool ULUEFileSystem::IsPackagedFile(const FString& UEPath)
+    {
+        return IsInPackageListing(UEPath)
+            || (CVarUsePrecompressedFiles.GetValueOnAnyThread() && IsInPackageListing(UEPath + CompressedFile::Extension));
+    }
+
+    void ULUEFileSystem::RebuildPackageListing()
+    {
+        ULUE_TRACE_SCOPE(TEXT("Ultralight RebuildPackageListing"));
+
+        // Walks pak entries and any loose staged files below the two roots; paths come back in the same
+        // form MapPath builds them, so lookups need no further normalization.
+        TSet<FString> Files;
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        auto AddTree = [&PlatformFile, &Files](const FString& Root)
+        {
+            PlatformFile.IterateDirectoryRecursively(*Root, [&Files](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+            {
+                if (!bIsDirectory)
+                {
+                    FString Filename(FilenameOrDirectory);
+                    FPaths::NormalizeFilename(Filename);
+                    Files.Add(MoveTemp(Filename));
+                }
+                return true;
+            });
+        };
+        AddTree(BaseDirectory);
+        if (ResourceDirectory != BaseDirectory)
+        {
+            AddTree(ResourceDirectory);
+        }
+
+        UE_LOG(LogTemp, Verbose, TEXT("ULUEFileSystem - Indexed %d packaged UI files"), Files.Num());
+
+        PackageListing = MoveTemp(Files);
+    }
+
+    void ULUEFileSystem::OnPakFileMounted(const IPakFile& PakFile)
+    {
+        // Mounts can happen on any thread; rebuild on the next lookup rather than here.
+        bListingDirty = true;
+        bPathStatesDirty = true;
+    }
+
+    FString ULUEFileSystem::ResolvePath(FUtf8StringView Source, EULUEPathState& OutState)
+    {
+        if (bPathStatesDirty.exchange(false))
+        {
+            PathCache.ResetStates();
+        }
+
+        FString Resolved;
+        if (PathCache.Find(Source, &Resolved, OutState, GetMissingTimeout()))
+        {
+            return Resolved;
+        }
+
+        Resolved = MapPath(Source);
+        OutState = EULUEPathState::Unknown;
+        PathCache.Add(Source, Resolved);
+        return Resolved;
+    }
+
+    bool ULUEFileSystem::FindPathState(FUtf8StringView Source, EULUEPathState& OutState)
+    {
+        if (bPathStatesDirty.exchange(false))
+        {
+            PathCache.ResetStates();
+        }
+        return PathCache.Find(Source, nullptr, OutState, GetMissingTimeout());
+    }
+
+    double ULUEFileSystem::GetMissingTimeout() const
+    {
+        // Packaged misses expire too: re-checking is only a listing lookup, and a miss cached for the whole session
+        // would turn one bad answer (e.g. a lookup racing a pak mount) into a permanent 404.
+        return FMath::Max(CVarMissingFileCacheSeconds.GetValueOnAnyThread(), 0.0f);
+    }
+
+    FString ULUEFileSystem::MapPath(FUtf8StringView UltralightPath) const
+    {
+        // StringCast converts short paths in an inline buffer.
+        const auto Converted = StringCast<TCHAR>(UltralightPath.GetData(), UltralightPath.Len());
+        return MapPath(FStringView(Converted.Get(), Converted.Length()));
+    }
+
+    FString ULUEFileSystem::MapPath(FStringView UltralightPath) const
     {
-        FString UltralightPath = FString(UTF8_TO_TCHAR(path.utf8().data()));
-        
         // Remove any leading slashes to avoid double slashes
-        while (UltralightPath.StartsWith(TEXT("/")))
+        int32 FirstChar = 0;
+        while (FirstChar < UltralightPath.Len() && UltralightPath[FirstChar] == TEXT('/'))
         {
-            UltralightPath = UltralightPath.Mid(1);
+            ++FirstChar;
         }
-        
-        // Ultralight built-in resources (cacert/icu data) are expected under the resource directory.
-        if (UltralightPath.StartsWith(TEXT("resources")))
+        UltralightPath.RightChopInline(FirstChar);
+
+        // Cache-busting queries (hot reload appends one to swapped stylesheets) don't name a different file.
+        int32 QueryStart = INDEX_NONE;
+        if (UltralightPath.FindChar(TEXT('?'), QueryStart))
         {
-            return ResourceDirectory / UltralightPath;
+            UltralightPath.LeftInline(QueryStart);
         }
 
-        return BaseDirectory / UltralightPath;
+        // Ultralight built-in resources (cacert/icu data) are expected under the resource directory.
+        const FString& Root = UltralightPath.StartsWith(TEXT("resources")) ? ResourceDirectory : BaseDirectory;
+
+        FString Result;
+        Result.Reserve(Root.Len() + 1 + UltralightPath.Len());
+        Result.Append(Root);
+        if (!Result.IsEmpty() && !Result.EndsWith(TEXT("/")))
+        {
+            Result.AppendChar(TEXT('/'));
+        }
+        Result.Append(UltralightPath.GetData(), UltralightPath.Len());
+        return Result;
     }
 
     ultralight::String ULUEFileSystem::GetMimeTypeFromExtension(const FString& Extension)
@@ -28,6 +28,16 @@
 
 // Include Ultralight headers with macro protection
 #include "ULUEUltralightIncludes.h"
+#include "FileSystem/ULUEFileCache.h"
+#include "FileSystem/ULUEBundle.h"
+#include "FileSystem/ULUEPathCache.h"
+#include "FileSystem/ULUEReadaheadManifest.h"
+#include "Async/AsyncFileHandle.h"
+#include "Misc/ScopeRWLock.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+class IPakFile;
 
 namespace ultralightue
 {
@@ -51,15 +61,54 @@ namespace ultralightue
         ULUEFileSystem();
         virtual ~ULUEFileSystem() override;
 
-        /// Set the filesystem access pattern
+        /// Set the filesystem access pattern. FSA_Package reads through the pak layer with async requests
+        /// and answers FileExists from a cached listing of the mounted content.
         void SetFSAccess(FSAccess InAccessPattern);
 
+        /// Access pattern for this build: FSA_Package when running on cooked data, FSA_Native otherwise.
+        static FSAccess GetDefaultFSAccess();
+
         /// Set the base directory for file operations
         void SetBaseDirectory(const FString& InBaseDirectory);
+        const FString& GetBaseDirectory() const { return BaseDirectory; }
 
         /// Set the resource directory (defaults to BaseDirectory). Used to serve Ultralight internal assets.
         void SetResourceDirectory(const FString& InResourceDirectory);
 
+        /// Serve files under the base directory from a cooked UI bundle (see FULUEBundle) before touching the
+        /// disk. Files missing from the bundle still fall back to loose files. Returns false if it can't be opened.
+        bool MountBundle(const FString& BundlePath);
+
+        /// Drop every cached file and path resolution. Buffers Ultralight still holds stay valid.
+        void TrimCaches();
+
+        /// Loads the readahead manifest (see FULUEReadaheadManifest); SeedPath is used until one has been saved.
+        void LoadReadaheadManifest(const FString& SavePath, const FString& SeedPath);
+
+        /// A view started loading URL. For file:/// pages, prefetches everything the page opened last time and
+        /// records what it opens now. Returns true if EndPageLoad must be called.
+        bool BeginPageLoad(const FString& URL);
+
+        /// The load finished (bCommit) or was abandoned. Committed recordings replace the page's manifest entry.
+        void EndPageLoad(const FString& URL, bool bCommit);
+
+        /// A file changed on disk: drop its cached contents and whatever is known about its existence.
+        void InvalidateFile(const FString& UEPath);
+
+        /// The Unreal path OpenFile would read for an Ultralight path (e.g. "menu/styles.css").
+        FString GetUEPath(FStringView UltralightPath) const;
+
+        /// Files URL opened the last time it finished loading, as recorded in the readahead manifest.
+        /// Empty if the page has never been recorded.
+        TArray<FString> GetPageDependencies(const FString& URL) const;
+
+        /// Content changed in ways we can't pin to single files: drop all contents and existence results.
+        void InvalidateAllFiles();
+
+        /// Start reading files (paths as Ultralight sees them, e.g. "menu/styles.css") in the background so
+        /// later OpenFile calls are cache hits. OpenFile joins a prefetch that is still in flight.
+        void Prefetch(TConstArrayView<FString> Paths, EAsyncIOPriorityAndFlags Priority = AIOP_Low);
+
         //~ Begin ultralight::FileSystem Interface
         
         /// Check if a file exists within the file system.
@@ -72,19 +121,87 @@ namespace ultralightue
         virtual ultralight::String GetFileCharset(const ultralight::String& file_path) override;
 
         /// Open a file for reading and map it to a Buffer.
+        /// Contents are served from an LRU cache (Ultralight.FileCacheSizeMB) without copying.
         virtual ultralight::RefPtr<ultralight::Buffer> OpenFile(const ultralight::String& file_path) override;
         
         //~ End ultralight::FileSystem Interface
 
     private:
         /// Map an Ultralight path to an Unreal Engine path
-        FString MapPath(const ultralight::String& path) const;
+        FString MapPath(FUtf8StringView UltralightPath) const;
+        FString MapPath(FStringView UltralightPath) const;
+
+        /// Resolved path for Source, from the path cache when possible. OutState is what is known about its existence.
+        FString ResolvePath(FUtf8StringView Source, EULUEPathState& OutState);
+
+        /// Cached state for Source without resolving it; false if Source has never been seen.
+        bool FindPathState(FUtf8StringView Source, EULUEPathState& OutState);
+
+        /// How long a Missing result is trusted before the file is checked again.
+        double GetMissingTimeout() const;
+
+        bool IsPackaged() const { return AccessPattern == FSAccess::FSA_Package; }
+
+        /// OpenFile after path resolution: cache, in-flight prefetch, bundle, then disk or pak.
+        ultralight::RefPtr<ultralight::Buffer> OpenResolvedFile(const FString& UEPath);
+
+        /// Ultralight resources (paths under ResourcePrefix) as a shared read-only mapping; null for other paths
+        /// or if mapping fails, in which case the regular read path serves them.
+        FULUEFileBlobPtr MapResourceFile(const FString& UEPath);
+        void UpdateResourcePrefix();
+
+        /// Maps or reads a loose file. Heap results are added to the content cache.
+        FULUEFileBlobPtr ReadNativeFile(const FString& UEPath);
+
+        /// Reads a packaged file, decoding its precompressed sibling instead when one is staged. Blocks the
+        /// calling thread; heap results are added to the content cache.
+        FULUEFileBlobPtr ReadPackagedFile(const FString& UEPath, EAsyncIOPriorityAndFlags Priority);
+
+        /// Reads exactly UEPath through IAsyncReadFileHandle so the pak precacher sees Priority.
+        FULUEFileBlobPtr ReadPackagedBlob(const FString& UEPath, EAsyncIOPriorityAndFlags Priority);
+
+        /// Looks UEPath up in the mounted bundle, if any and if it lies under the base directory.
+        FULUEFileBlobPtr FindInBundle(const FString& UEPath) const;
+        bool IsInBundle(const FString& UEPath) const;
+        bool GetBundleRelativePath(const FString& UEPath, FStringView& OutRelativePath) const;
+
+        /// Caches heap blobs; mapped blobs are passed through untouched.
+        void AddToCache(const FString& UEPath, const FULUEFileBlobPtr& Blob);
+
+        /// Hash lookup in the listing of mounted content, rebuilt lazily after a pak mounts.
+        bool IsInPackageListing(const FString& UEPath);
+
+        /// UEPath or its precompressed sibling is in the package listing.
+        bool IsPackagedFile(const FString& UEPath);
+        /// Caller holds ListingLock for writing.
+        void RebuildPackageListing();
+        void OnPakFileMounted(const IPakFile& PakFile);
 
         /// Get mime type from file extension
         static ultralight::String GetMimeTypeFromExtension(const FString& Extension);
 
         FString BaseDirectory;
         FString ResourceDirectory;
+        /// Where MapPath puts "resources/...".
+        FString ResourcePrefix;
         FSAccess AccessPattern = FSAccess::FSA_Native;
+
+        FULUEFileCache ContentCache;
+        TSharedPtr<FULUEBundle> ContentBundle;
+
+        FULUEPathCache PathCache;
+        FULUEReadaheadManifest Readahead;
+        std::atomic<bool> bPathStatesDirty{ false };
+
+        FRWLock ListingLock;
+        TSet<FString> PackageListing;
+        std::atomic<bool> bListingDirty{ true };
+        FDelegateHandle PakMountedHandle;
+
+        FCriticalSection ResourceMappingsLock;
+        TMap<FString, FULUEFileBlobPtr> ResourceMappings;
+
+        FCriticalSection PendingReadsLock;
+        TMap<FString, UE::Tasks::TTask<FULUEFileBlobPtr>> PendingReads;
     };
 }
@@ -0,0 +1,114 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#include "FileSystem/ULUEPathCache.h"
+#include "Hash/CityHash.h"
+
+namespace ultralightue
+{
+    namespace
+    {
+        /// Ultralight probes a bounded set of paths; if something generates unbounded ones, start over.
+        constexpr int32 MaxEntries = 16384;
+    }
+
+    uint64 FULUEPathCache::HashSource(FUtf8StringView Source)
+    {
+        return CityHash64(reinterpret_cast<const char*>(Source.GetData()), Source.Len());
+    }
+
+    const FULUEPathCache::FEntry* FULUEPathCache::FindEntry(FUtf8StringView Source, uint64 Hash) const
+    {
+        // The hash is the key; compare the bytes so a collision is a miss rather than a wrong file.
+        const FEntry* Entry = Entries.Find(Hash);
+        if (Entry && Entry->Source.Num() == Source.Len() && FMemory::Memcmp(Entry->Source.GetData(), Source.GetData(), Source.Len()) == 0)
+        {
+            return Entry;
+        }
+        return nullptr;
+    }
+
+    FULUEPathCache::FEntry* FULUEPathCache::FindEntry(FUtf8StringView Source, uint64 Hash)
+    {
+        return const_cast<FEntry*>(static_cast<const FULUEPathCache*>(this)->FindEntry(Source, Hash));
+    }
+
+    bool FULUEPathCache::Find(FUtf8StringView Source, FString* OutResolved, EULUEPathState& OutState, double MissingTimeout) const
+    {
+        const uint64 Hash = HashSource(Source);
+        FReadScopeLock ScopeLock(Lock);
+        const FEntry* Entry = FindEntry(Source, Hash);
+        if (!Entry)
+        {
+            return false;
+        }
+
+        OutState = Entry->State;
+        if (OutState == EULUEPathState::Missing && MissingTimeout >= 0.0 && FPlatformTime::Seconds() - Entry->StateTime > MissingTimeout)
+        {
+            OutState = EULUEPathState::Unknown;
+        }
+        if (OutResolved)
+        {
+            *OutResolved = Entry->Resolved;
+        }
+        return true;
+    }
+
+    void FULUEPathCache::Add(FUtf8StringView Source, const FString& Resolved, EULUEPathState State)
+    {
+        const uint64 Hash = HashSource(Source);
+        FWriteScopeLock ScopeLock(Lock);
+        if (Entries.Num() >= MaxEntries)
+        {
+            Entries.Reset();
+        }
+
+        FEntry& Entry = Entries.FindOrAdd(Hash);
+        Entry.Source.Reset(Source.Len());
+        Entry.Source.Append(Source.GetData(), Source.Len());
+        Entry.Resolved = Resolved;
+        Entry.State = State;
+        Entry.StateTime = FPlatformTime::Seconds();
+    }
+
+    void FULUEPathCache::SetState(FUtf8StringView Source, EULUEPathState State)
+    {
+        const uint64 Hash = HashSource(Source);
+        FWriteScopeLock ScopeLock(Lock);
+        if (FEntry* Entry = FindEntry(Source, Hash))
+        {
+            Entry->State = State;
+            Entry->StateTime = FPlatformTime::Seconds();
+        }
+    }
+
+    void FULUEPathCache::Invalidate(const FString& Resolved)
+    {
+        FWriteScopeLock ScopeLock(Lock);
+        for (TPair<uint64, FEntry>& Pair : Entries)
+        {
+            if (Pair.Value.Resolved.Equals(Resolved, ESearchCase::IgnoreCase))
+            {
+                Pair.Value.State = EULUEPathState::Unknown;
+            }
+        }
+    }
+
+    void FULUEPathCache::ResetStates()
+    {
+        FWriteScopeLock ScopeLock(Lock);
+        for (TPair<uint64, FEntry>& Pair : Entries)
+        {
+            Pair.Value.State = EULUEPathState::Unknown;
+        }
+    }
+
+    void FULUEPathCache::Empty()
+    {
+        FWriteScopeLock ScopeLock(Lock);
+        Entries.Empty();
+    }
+}
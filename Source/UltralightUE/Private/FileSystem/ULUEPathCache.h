@@ -0,0 +1,60 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace ultralightue
+{
+    enum class EULUEPathState : uint8
+    {
+        Unknown,
+        Exists,
+        Missing,
+    };
+
+    /// @brief Thread-safe map from the UTF-8 path Ultralight asks for to the resolved Unreal path, plus whether that
+    /// path exists. Lookups hash the caller's bytes directly, so a state-only hit (FileExists) allocates nothing;
+    /// OpenFile still copies the resolved path out. A cached Missing answers FileExists/OpenFile without touching the disk.
+    class FULUEPathCache
+    {
+    public:
+        /// Returns false on a miss. Missing states older than MissingTimeout seconds come back as Unknown
+        /// (a negative timeout never expires them). OutResolved may be null when only the state is needed.
+        bool Find(FUtf8StringView Source, FString* OutResolved, EULUEPathState& OutState, double MissingTimeout) const;
+
+        void Add(FUtf8StringView Source, const FString& Resolved, EULUEPathState State = EULUEPathState::Unknown);
+        void SetState(FUtf8StringView Source, EULUEPathState State);
+
+        /// Forget existence for every source that resolves to Resolved (after that file changed on disk).
+        void Invalidate(const FString& Resolved);
+
+        /// Forget existence for everything but keep resolutions (content changed, directories didn't).
+        void ResetStates();
+
+        /// Forget everything (directories changed).
+        void Empty();
+
+    private:
+        struct FEntry
+        {
+            TArray<UTF8CHAR> Source;
+            FString Resolved;
+            EULUEPathState State = EULUEPathState::Unknown;
+            double StateTime = 0.0;
+        };
+
+        /// Lock must be held.
+        FEntry* FindEntry(FUtf8StringView Source, uint64 Hash);
+        const FEntry* FindEntry(FUtf8StringView Source, uint64 Hash) const;
+
+        static uint64 HashSource(FUtf8StringView Source);
+
+        mutable FRWLock Lock;
+        TMap<uint64, FEntry> Entries;
+    };
+}
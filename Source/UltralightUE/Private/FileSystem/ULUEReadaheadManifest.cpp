@@ -0,0 +1,184 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#include "FileSystem/ULUEReadaheadManifest.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+namespace ultralightue
+{
+    namespace
+    {
+        /// Pages that pull in more than this are cut off; the tail is rarely on the critical path.
+        constexpr int32 MaxFilesPerPage = 256;
+        const TCHAR* ManifestHeader = TEXT("# UltralightUE readahead manifest v1");
+    }
+
+    FString FULUEReadaheadManifest::NormalizePath(FStringView Path)
+    {
+        if (Path.StartsWith(TEXT("file://"), ESearchCase::IgnoreCase))
+        {
+            Path.RightChopInline(7);
+        }
+
+        // Whichever comes first ends the path: "a.html#x?y" has a fragment and no query.
+        int32 QueryStart = INDEX_NONE;
+        int32 FragmentStart = INDEX_NONE;
+        Path.FindChar(TEXT('?'), QueryStart);
+        Path.FindChar(TEXT('#'), FragmentStart);
+        if (QueryStart != INDEX_NONE || FragmentStart != INDEX_NONE)
+        {
+            Path.LeftInline(QueryStart == INDEX_NONE ? FragmentStart : FragmentStart == INDEX_NONE ? QueryStart : FMath::Min(QueryStart, FragmentStart));
+        }
+
+        int32 FirstChar = 0;
+        while (FirstChar < Path.Len() && Path[FirstChar] == TEXT('/'))
+        {
+            ++FirstChar;
+        }
+        return FString(Path.RightChop(FirstChar));
+    }
+
+    void FULUEReadaheadManifest::Load(const FString& InSavePath, const FString& SeedPath)
+    {
+        TArray<FString> Lines;
+        const FString& LoadPath = IFileManager::Get().FileExists(*InSavePath) ? InSavePath : SeedPath;
+        FFileHelper::LoadFileToStringArray(Lines, *LoadPath);
+
+        FScopeLock ScopeLock(&Lock);
+        SavePath = InSavePath;
+        Pages.Reset();
+
+        TArray<FString>* CurrentPage = nullptr;
+        for (const FString& Line : Lines)
+        {
+            if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+            {
+                continue;
+            }
+            if (Line.StartsWith(TEXT(">")))
+            {
+                CurrentPage = &Pages.FindOrAdd(Line.RightChop(1));
+            }
+            else if (CurrentPage && CurrentPage->Num() < MaxFilesPerPage)
+            {
+                CurrentPage->Add(Line);
+            }
+        }
+        bDirty = false;
+    }
+
+    void FULUEReadaheadManifest::Save()
+    {
+        FString Contents;
+        FString Path;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (!bDirty || SavePath.IsEmpty())
+            {
+                return;
+            }
+            bDirty = false;
+            Path = SavePath;
+
+            Contents = ManifestHeader;
+            Contents += LINE_TERMINATOR;
+            for (const TPair<FString, TArray<FString>>& Page : Pages)
+            {
+                Contents += TEXT(">") + Page.Key + LINE_TERMINATOR;
+                for (const FString& File : Page.Value)
+                {
+                    Contents += File + LINE_TERMINATOR;
+                }
+            }
+        }
+
+        FFileHelper::SaveStringToFile(Contents, *Path);
+    }
+
+    TArray<FString> FULUEReadaheadManifest::GetDependencies(const FString& EntryPage) const
+    {
+        FScopeLock ScopeLock(&Lock);
+        const TArray<FString>* Files = Pages.Find(EntryPage);
+        return Files ? *Files : TArray<FString>();
+    }
+
+    void FULUEReadaheadManifest::BeginRecording(const FString& EntryPage)
+    {
+        FScopeLock ScopeLock(&Lock);
+        FRecording& Recording = Recordings.FindOrAdd(EntryPage);
+        if (Recording.RefCount++ == 0)
+        {
+            NumRecordings.fetch_add(1, std::memory_order_relaxed);
+        }
+        MarkOverlappingRecordings();
+    }
+
+    void FULUEReadaheadManifest::EndRecording(const FString& EntryPage, bool bCommit)
+    {
+        FScopeLock ScopeLock(&Lock);
+        FRecording* Recording = Recordings.Find(EntryPage);
+        if (!Recording || --Recording->RefCount > 0)
+        {
+            return;
+        }
+
+        if (bCommit && !Recording->bOverlapped && Recording->Files.Num() > 0)
+        {
+            TArray<FString>& Stored = Pages.FindOrAdd(EntryPage);
+            if (Stored != Recording->Files)
+            {
+                Stored = MoveTemp(Recording->Files);
+                bDirty = true;
+            }
+        }
+        Recordings.Remove(EntryPage);
+        NumRecordings.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void FULUEReadaheadManifest::RecordAccess(FUtf8StringView Path)
+    {
+        if (NumRecordings.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+
+        const auto Converted = StringCast<TCHAR>(Path.GetData(), Path.Len());
+        const FString File = NormalizePath(FStringView(Converted.Get(), Converted.Length()));
+
+        // Ultralight's own resources load once at startup and aren't page dependencies.
+        if (File.IsEmpty() || File.StartsWith(TEXT("resources/")))
+        {
+            return;
+        }
+
+        FScopeLock ScopeLock(&Lock);
+        if (Recordings.Num() != 1)
+        {
+            return;
+        }
+
+        FRecording& Recording = Recordings.CreateIterator().Value();
+        if (!Recording.bOverlapped && Recording.Files.Num() < MaxFilesPerPage && !Recording.Seen.Contains(File))
+        {
+            Recording.Seen.Add(File);
+            Recording.Files.Add(File);
+        }
+    }
+
+    void FULUEReadaheadManifest::MarkOverlappingRecordings()
+    {
+        // Opens can't be traced back to the view that made them, so pages loading side by side would record each
+        // other's files (and hot reload would then reload both on either's edits). Their recordings are dropped.
+        if (Recordings.Num() > 1)
+        {
+            for (TPair<FString, FRecording>& Pair : Recordings)
+            {
+                Pair.Value.bOverlapped = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+namespace ultralightue
+{
+    /// @brief Per entry page ("menu.html"), the ordered list of files it opened the last time it loaded.
+    ///
+    /// Persisted as plain text: a ">page" line followed by one dependency per line, all paths as Ultralight
+    /// sees them (relative to uicontent). Thread-safe; recording happens on whatever thread calls OpenFile.
+    class FULUEReadaheadManifest
+    {
+    public:
+        /// Loads SavePath, or SeedPath (a manifest shipped with the game) when nothing has been saved yet.
+        /// Later saves always go to SavePath.
+        void Load(const FString& InSavePath, const FString& SeedPath);
+
+        /// Writes the manifest if a recording changed it.
+        void Save();
+
+        TArray<FString> GetDependencies(const FString& EntryPage) const;
+
+        /// Starts collecting every file opened until the matching EndRecording. Concurrent loads of the same
+        /// page share one recording; recordings of different pages that overlap are never committed.
+        void BeginRecording(const FString& EntryPage);
+
+        /// Stops collecting. The list replaces the stored one if bCommit and anything was recorded.
+        void EndRecording(const FString& EntryPage, bool bCommit);
+
+        /// Adds Path to the active recording, if exactly one is. Cheap when nothing is recording.
+        void RecordAccess(FUtf8StringView Path);
+
+        /// Strips slashes, the file:/// scheme, query and fragment, so URLs and file system paths compare equal.
+        static FString NormalizePath(FStringView Path);
+
+    private:
+        struct FRecording
+        {
+            TArray<FString> Files;
+            TSet<FString> Seen;
+            int32 RefCount = 0;
+            /// Another page recorded at the same time, so Files may hold its dependencies too.
+            bool bOverlapped = false;
+        };
+
+        /// Caller holds Lock.
+        void MarkOverlappingRecordings();
+
+        mutable FCriticalSection Lock;
+        TMap<FString, TArray<FString>> Pages;
+        TMap<FString, FRecording> Recordings;
+        std::atomic<int32> NumRecordings{ 0 };
+        FString SavePath;
+        bool bDirty = false;
+    };
+}
@@ -0,0 +1,689 @@
+/*
+ * Font loader for Ultralight.
+ */
+
+#include "Fonts/ULUEFontLoader.h"
+#include "FileSystem/ULUEFileSystem.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "ULUELogInterface.h"
+#include "ULUEStats.h"
+#include "Algo/BinarySearch.h"
+#include "AppCore/Platform.h"
+#include <atomic>
+
+namespace ultralightue
+{
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarSystemFonts(
+		TEXT("Ultralight.SystemFonts"),
+		true,
+		TEXT("Fall back to the platform's installed fonts for families not shipped under uicontent/fonts. ")
+		TEXT("When off, system font discovery never runs."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<FString> CVarDefaultFontFamily(
+		TEXT("Ultralight.DefaultFontFamily"),
+		TEXT(""),
+		TEXT("Family used when a page's font can't be found. Empty uses the platform default, or the first project family when system fonts are off."),
+		ECVF_Default);
+
+	std::atomic<int64> GFallbackHits{ 0 };
+	std::atomic<int64> GFallbackMisses{ 0 };
+
+	FAutoConsoleCommand GLogFontFallbackCommand(
+		TEXT("Ultralight.LogFontFallback"),
+		TEXT("Logs how often font fallback for mixed-script text was answered from the fallback cache."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			const int64 Hits = GFallbackHits.load(std::memory_order_relaxed);
+			const int64 Misses = GFallbackMisses.load(std::memory_order_relaxed);
+			UE_LOG(LogUltralightUE, Display, TEXT("Font fallback: %lld lookups, %lld cache misses (%.1f%% hit rate)"),
+				Hits + Misses, Misses, Hits + Misses > 0 ? 100.0 * Hits / (Hits + Misses) : 0.0);
+		}));
+
+	const TCHAR* FontDirectoryName = TEXT("fonts");
+	const TCHAR* FontIndexName = TEXT("fontindex.txt");
+	const TCHAR* FontIndexHeader = TEXT("# UltralightUE font index v1: family, weight, italic, path");
+
+	constexpr uint32 MakeTag(char A, char B, char C, char D)
+	{
+		return (uint32(uint8(A)) << 24) | (uint32(uint8(B)) << 16) | (uint32(uint8(C)) << 8) | uint32(uint8(D));
+	}
+
+	/// Bounds-checked big-endian reads; any read past the end marks the reader as failed.
+	struct FFontReader
+	{
+		TConstArrayView<uint8> Data;
+		bool bFailed = false;
+
+		uint16 U16(int64 Offset)
+		{
+			if (Offset < 0 || Offset + 2 > Data.Num())
+			{
+				bFailed = true;
+				return 0;
+			}
+			return uint16(Data[Offset] << 8 | Data[Offset + 1]);
+		}
+
+		uint32 U32(int64 Offset)
+		{
+			return uint32(U16(Offset)) << 16 | U16(Offset + 2);
+		}
+	};
+
+	/// Offset of Tag in the first face of a font file or collection; 0 if missing or not a font.
+	int64 FindFontTable(FFontReader& Reader, uint32 Tag)
+	{
+		int64 FontOffset = 0;
+		if (Reader.U32(0) == MakeTag('t', 't', 'c', 'f'))
+		{
+			FontOffset = Reader.U32(12);
+		}
+
+		const uint32 Version = Reader.U32(FontOffset);
+		if (Version != 0x00010000 && Version != MakeTag('O', 'T', 'T', 'O') && Version != MakeTag('t', 'r', 'u', 'e'))
+		{
+			return 0;
+		}
+
+		const uint16 NumTables = Reader.U16(FontOffset + 4);
+		for (uint16 Index = 0; Index < NumTables && !Reader.bFailed; ++Index)
+		{
+			const int64 Record = FontOffset + 12 + Index * 16;
+			if (Reader.U32(Record) == Tag)
+			{
+				return Reader.U32(Record + 8);
+			}
+		}
+		return 0;
+	}
+
+	FString ReadFamilyName(FFontReader& Reader, int64 NameTable)
+	{
+		const uint16 Count = Reader.U16(NameTable + 2);
+		const int64 Storage = NameTable + Reader.U16(NameTable + 4);
+
+		// Prefer the typographic family (16) over the legacy one (1), Unicode over Mac Roman, US English over the rest.
+		int32 BestScore = -1;
+		int64 BestRecord = 0;
+		for (uint16 Index = 0; Index < Count && !Reader.bFailed; ++Index)
+		{
+			const int64 Record = NameTable + 6 + Index * 12;
+			const uint16 Platform = Reader.U16(Record);
+			const uint16 Encoding = Reader.U16(Record + 2);
+			const uint16 Language = Reader.U16(Record + 4);
+			const uint16 NameId = Reader.U16(Record + 6);
+			const bool bUnicode = Platform == 0 || (Platform == 3 && (Encoding == 1 || Encoding == 10));
+			const bool bMacRoman = Platform == 1 && Encoding == 0;
+			if ((NameId != 1 && NameId != 16) || (!bUnicode && !bMacRoman))
+			{
+				continue;
+			}
+
+			const int32 Score = (NameId == 16 ? 4 : 0) + (bUnicode ? 2 : 0) + (Language == 0x409 || (bMacRoman && Language == 0) ? 1 : 0);
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				BestRecord = Record;
+			}
+		}
+
+		FString Name;
+		if (BestScore < 0)
+		{
+			return Name;
+		}
+
+		const bool bUnicode = Reader.U16(BestRecord) != 1;
+		const int64 Length = Reader.U16(BestRecord + 8);
+		const int64 Start = Storage + Reader.U16(BestRecord + 10);
+		if (Start + Length > Reader.Data.Num())
+		{
+			return Name;
+		}
+
+		// Family names are BMP text; code units are appended as-is.
+		for (int64 Offset = 0; Offset < Length; Offset += bUnicode ? 2 : 1)
+		{
+			Name.AppendChar(static_cast<TCHAR>(bUnicode ? Reader.U16(Start + Offset) : Reader.Data[Start + Offset]));
+		}
+		return Name.TrimStartAndEnd();
+	}
+
+	/// Font files under ContentDirectory/fonts, as paths relative to ContentDirectory.
+	TArray<FString> FindFontFiles(const FString& ContentDirectory)
+	{
+		const FString FontDirectory = FPaths::Combine(ContentDirectory, FontDirectoryName);
+		TArray<FString> Found;
+		IFileManager::Get().FindFilesRecursive(Found, *FontDirectory, TEXT("*"), true, false);
+
+		TArray<FString> FontFiles;
+		for (const FString& File : Found)
+		{
+			const FString Extension = FPaths::GetExtension(File);
+			if (Extension == TEXT("ttf") || Extension == TEXT("otf") || Extension == TEXT("ttc"))
+			{
+				FontFiles.Add(FPaths::Combine(FontDirectoryName, File.RightChop(FontDirectory.Len() + 1)));
+			}
+		}
+		FontFiles.Sort();
+		return FontFiles;
+	}
+
+	FString ToFString(const ultralight::String& String)
+	{
+		const ultralight::String8& Utf8 = String.utf8();
+		return FString(FUTF8ToTCHAR(Utf8.data(), static_cast<int32>(Utf8.length())));
+	}
+
+	ultralight::String ToUltralightString(const FString& String)
+	{
+		return ultralight::String(TCHAR_TO_UTF8(*String));
+	}
+
+	/// Joiners, variation selectors, combining marks and the like ride along with any script.
+	bool IsScriptNeutral(uint32 Codepoint)
+	{
+		return Codepoint < 0x80
+			|| (Codepoint >= 0x0300 && Codepoint <= 0x036F)
+			|| (Codepoint >= 0x200B && Codepoint <= 0x200F)
+			|| (Codepoint >= 0xFE00 && Codepoint <= 0xFE0F)
+			|| (Codepoint >= 0x1F3FB && Codepoint <= 0x1F3FF)
+			|| (Codepoint >= 0xE0000 && Codepoint <= 0xE01EF);
+	}
+
+	/// The character that decides which font a run falls back to: its first one that isn't script-neutral,
+	/// else its first one. Decodes the string's UTF-8 in place.
+	uint32 GetFallbackCodepoint(const ultralight::String& Characters)
+	{
+		const ultralight::String8& Utf8 = Characters.utf8();
+		const uint8* Bytes = reinterpret_cast<const uint8*>(Utf8.data());
+		const size_t Length = Utf8.length();
+
+		uint32 First = 0;
+		for (size_t Offset = 0; Offset < Length;)
+		{
+			const uint8 Lead = Bytes[Offset];
+			const int32 NumBytes = Lead < 0x80 ? 1 : Lead < 0xE0 ? 2 : Lead < 0xF0 ? 3 : 4;
+			if (Offset + NumBytes > Length)
+			{
+				break;
+			}
+
+			uint32 Codepoint = NumBytes == 1 ? Lead : Lead & (0xFF >> (NumBytes + 1));
+			for (int32 Continuation = 1; Continuation < NumBytes; ++Continuation)
+			{
+				Codepoint = Codepoint << 6 | (Bytes[Offset + Continuation] & 0x3F);
+			}
+			Offset += NumBytes;
+
+			if (!IsScriptNeutral(Codepoint))
+			{
+				return Codepoint;
+			}
+			First = Offset == static_cast<size_t>(NumBytes) ? Codepoint : First;
+		}
+		return First;
+	}
+
+	/// Distance from Available to Desired per CSS font matching: 400-500 look up to 500 first, lighter
+	/// requests prefer lighter faces and bolder ones bolder faces.
+	int32 GetWeightDistance(int32 Available, int32 Desired)
+	{
+		if (Available == Desired)
+		{
+			return 0;
+		}
+		if (Desired >= 400 && Desired <= 500 && Available > Desired && Available <= 500)
+		{
+			return Available - Desired;
+		}
+		const bool bPreferLighter = Desired <= 500;
+		const bool bLighter = Available < Desired;
+		return FMath::Abs(Available - Desired) + (bLighter == bPreferLighter ? 0 : 1000);
+	}
+
+	/// In-memory font backed by a file system buffer. The hash is derived from the path, so it is stable
+	/// across runs and identical for every view that loads the file.
+	class FULUEFontFile final : public ultralight::FontFile
+	{
+	public:
+		FULUEFontFile(ultralight::RefPtr<ultralight::Buffer> InBuffer, uint32 InHash)
+			: Buffer(MoveTemp(InBuffer))
+			, Hash(InHash)
+		{
+		}
+
+		virtual void AddRef() const override { RefCount.fetch_add(1, std::memory_order_relaxed); }
+		virtual void Release() const override
+		{
+			if (RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				delete this;
+			}
+		}
+		virtual int ref_count() const override { return RefCount.load(std::memory_order_relaxed); }
+
+		virtual bool is_in_memory() const override { return true; }
+		virtual ultralight::String filepath() const override { return ultralight::String(); }
+		virtual ultralight::RefPtr<ultralight::Buffer> buffer() const override { return Buffer; }
+		virtual uint32_t hash() const override { return Hash; }
+
+	private:
+		virtual ~FULUEFontFile() override = default;
+
+		ultralight::RefPtr<ultralight::Buffer> Buffer;
+		uint32 Hash = 0;
+		mutable std::atomic<int> RefCount{ 1 };
+	};
+}
+
+bool ParseFontFace(TConstArrayView<uint8> Data, FULUEFontFace& OutFace)
+{
+	FFontReader Reader{ Data };
+	const int64 NameTable = FindFontTable(Reader, MakeTag('n', 'a', 'm', 'e'));
+	const int64 OS2Table = FindFontTable(Reader, MakeTag('O', 'S', '/', '2'));
+	const int64 HeadTable = FindFontTable(Reader, MakeTag('h', 'e', 'a', 'd'));
+	if (Reader.bFailed || NameTable == 0)
+	{
+		return false;
+	}
+
+	OutFace.Family = ReadFamilyName(Reader, NameTable);
+	if (OS2Table != 0)
+	{
+		// usWeightClass; some old fonts store 1-9 instead of 100-900. fsSelection bit 0 is italic, bit 9 oblique.
+		const int32 WeightClass = Reader.U16(OS2Table + 4);
+		OutFace.Weight = FMath::Clamp(WeightClass < 10 ? WeightClass * 100 : WeightClass, 1, 1000);
+		OutFace.bItalic = (Reader.U16(OS2Table + 62) & 0x0201) != 0;
+	}
+	else if (HeadTable != 0)
+	{
+		const uint16 MacStyle = Reader.U16(HeadTable + 44);
+		OutFace.Weight = (MacStyle & 0x1) ? 700 : 400;
+		OutFace.bItalic = (MacStyle & 0x2) != 0;
+	}
+
+	return !Reader.bFailed && !OutFace.Family.IsEmpty();
+}
+
+bool ParseFontCoverage(TConstArrayView<uint8> Data, TArray<FULUECodepointRange>& OutRanges)
+{
+	FFontReader Reader{ Data };
+	const int64 CmapTable = FindFontTable(Reader, MakeTag('c', 'm', 'a', 'p'));
+	if (Reader.bFailed || CmapTable == 0)
+	{
+		return false;
+	}
+
+	// Prefer a full-repertoire subtable (format 12) over a BMP-only one (format 4).
+	int64 BestSubtable = 0;
+	uint16 BestFormat = 0;
+	const uint16 NumSubtables = Reader.U16(CmapTable + 2);
+	for (uint16 Index = 0; Index < NumSubtables && !Reader.bFailed; ++Index)
+	{
+		const int64 Record = CmapTable + 4 + Index * 8;
+		const uint16 Platform = Reader.U16(Record);
+		const uint16 Encoding = Reader.U16(Record + 2);
+		const int64 Subtable = CmapTable + Reader.U32(Record + 4);
+		const bool bUnicode = Platform == 0 || (Platform == 3 && (Encoding == 1 || Encoding == 10));
+		const uint16 Format = Reader.U16(Subtable);
+		if (bUnicode && (Format == 12 || Format == 4) && Format > BestFormat)
+		{
+			BestFormat = Format;
+			BestSubtable = Subtable;
+		}
+	}
+
+	TArray<FULUECodepointRange> Ranges;
+	if (BestFormat == 12)
+	{
+		const uint32 NumGroups = Reader.U32(BestSubtable + 12);
+		for (uint32 Group = 0; Group < NumGroups && !Reader.bFailed; ++Group)
+		{
+			const int64 Record = BestSubtable + 16 + static_cast<int64>(Group) * 12;
+			Ranges.Add({ Reader.U32(Record), Reader.U32(Record + 4) });
+		}
+	}
+	else if (BestFormat == 4)
+	{
+		const int64 SegCount = Reader.U16(BestSubtable + 6) / 2;
+		const int64 EndCodes = BestSubtable + 14;
+		const int64 StartCodes = EndCodes + SegCount * 2 + 2;
+		for (int64 Segment = 0; Segment < SegCount && !Reader.bFailed; ++Segment)
+		{
+			const uint16 Start = Reader.U16(StartCodes + Segment * 2);
+			const uint16 End = Reader.U16(EndCodes + Segment * 2);
+			// The last segment is the 0xFFFF terminator.
+			if (Start != 0xFFFF && Start <= End)
+			{
+				Ranges.Add({ Start, End });
+			}
+		}
+	}
+
+	if (Reader.bFailed || Ranges.Num() == 0)
+	{
+		return false;
+	}
+
+	Ranges.Sort([](const FULUECodepointRange& A, const FULUECodepointRange& B) { return A.First < B.First; });
+	OutRanges.Reset();
+	for (const FULUECodepointRange& Range : Ranges)
+	{
+		if (OutRanges.Num() > 0 && Range.First <= OutRanges.Last().Last + 1)
+		{
+			OutRanges.Last().Last = FMath::Max(OutRanges.Last().Last, Range.Last);
+		}
+		else
+		{
+			OutRanges.Add(Range);
+		}
+	}
+	return true;
+}
+
+int32 WriteFontIndex(const FString& ContentDirectory)
+{
+	FString Index = FString(FontIndexHeader) + LINE_TERMINATOR;
+	int32 NumFaces = 0;
+	for (const FString& Path : FindFontFiles(ContentDirectory))
+	{
+		TArray<uint8> Data;
+		FULUEFontFace Face;
+		if (!FFileHelper::LoadFileToArray(Data, *FPaths::Combine(ContentDirectory, Path)) || !ParseFontFace(Data, Face))
+		{
+			UE_LOG(LogUltralightUE, Warning, TEXT("Skipping font %s: not a TrueType/OpenType file"), *Path);
+			continue;
+		}
+		Index += FString::Printf(TEXT("%s\t%d\t%d\t%s"), *Face.Family, Face.Weight, Face.bItalic ? 1 : 0, *Path) + LINE_TERMINATOR;
+		++NumFaces;
+	}
+
+	const FString IndexPath = FPaths::Combine(ContentDirectory, FontDirectoryName, FontIndexName);
+	if (NumFaces == 0)
+	{
+		IFileManager::Get().Delete(*IndexPath, false, false, true);
+		return 0;
+	}
+
+	FFileHelper::SaveStringToFile(Index, *IndexPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	UE_LOG(LogUltralightUE, Display, TEXT("Wrote font index with %d faces to %s"), NumFaces, *IndexPath);
+	return NumFaces;
+}
+
+ULUEFontLoader::ULUEFontLoader(ULUEFileSystem& InFileSystem)
+	: FileSystem(InFileSystem)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	LoadIndex();
+	const int32 NumIndexed = NumFaces;
+	AddUnindexedFaces();
+
+	TArray<FString> FamilyNames;
+	Families.GetKeys(FamilyNames);
+	FamilyNames.Sort();
+	DefaultFamily = FamilyNames.Num() > 0 ? Families[FamilyNames[0]][0].Family : FString();
+
+	UE_LOG(LogUltralightUE, Log, TEXT("Ultralight fonts: %d faces in %d families, %d from %s and %d parsed (%.2f ms)"),
+		NumFaces, Families.Num(), NumIndexed, FontIndexName, NumFaces - NumIndexed, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+ULUEFontLoader::~ULUEFontLoader() = default;
+
+void ULUEFontLoader::LoadIndex()
+{
+	const FString IndexPath = FPaths::Combine(FontDirectoryName, FontIndexName);
+	const ultralight::RefPtr<ultralight::Buffer> Index = FileSystem.OpenFile(ToUltralightString(IndexPath));
+	if (!Index)
+	{
+		return;
+	}
+
+	const FUTF8ToTCHAR Converted(static_cast<const ANSICHAR*>(Index->data()), static_cast<int32>(Index->size()));
+	TArray<FString> Lines;
+	FString(Converted.Length(), Converted.Get()).ParseIntoArrayLines(Lines);
+
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Fields;
+		if (Line.StartsWith(TEXT("#")) || Line.ParseIntoArray(Fields, TEXT("\t"), false) != 4)
+		{
+			continue;
+		}
+
+		FULUEFontFace Face;
+		Face.Family = Fields[0];
+		Face.Weight = FCString::Atoi(*Fields[1]);
+		Face.bItalic = Fields[2] == TEXT("1");
+		Face.Path = Fields[3];
+		AddFace(MoveTemp(Face));
+	}
+}
+
+void ULUEFontLoader::AddUnindexedFaces()
+{
+	// The UltralightBundle commandlet writes the index next to the source fonts, so in the editor it can predate fonts
+	// added since. Those (every file, without an index) are parsed once here; cooked builds find nothing new.
+	TSet<FString> IndexedPaths;
+	for (const TPair<FString, TArray<FULUEFontFace>>& Family : Families)
+	{
+		for (const FULUEFontFace& Face : Family.Value)
+		{
+			IndexedPaths.Add(Face.Path);
+		}
+	}
+
+	for (const FString& Path : FindFontFiles(FileSystem.GetBaseDirectory()))
+	{
+		if (IndexedPaths.Contains(Path))
+		{
+			continue;
+		}
+
+		const ultralight::RefPtr<ultralight::Buffer> Data = FileSystem.OpenFile(ToUltralightString(Path));
+		FULUEFontFace Face;
+		if (Data && ParseFontFace(TConstArrayView<uint8>(static_cast<const uint8*>(Data->data()), static_cast<int32>(Data->size())), Face))
+		{
+			Face.Path = Path;
+			AddFace(MoveTemp(Face));
+		}
+	}
+}
+
+void ULUEFontLoader::AddFace(FULUEFontFace&& Face)
+{
+	Families.FindOrAdd(Face.Family.ToLower()).Add(MoveTemp(Face));
+	++NumFaces;
+}
+
+const FULUEFontFace* ULUEFontLoader::FindFace(const FString& Family, int32 Weight, bool bItalic) const
+{
+	const TArray<FULUEFontFace>* Faces = Families.Find(Family.ToLower());
+	if (!Faces)
+	{
+		return nullptr;
+	}
+
+	const FULUEFontFace* Best = nullptr;
+	int32 BestScore = MAX_int32;
+	for (const FULUEFontFace& Face : *Faces)
+	{
+		const int32 Score = (Face.bItalic != bItalic ? 100000 : 0) + GetWeightDistance(Face.Weight, Weight);
+		if (Score < BestScore)
+		{
+			BestScore = Score;
+			Best = &Face;
+		}
+	}
+	return Best;
+}
+
+ultralight::RefPtr<ultralight::FontFile> ULUEFontLoader::GetFontFile(const FString& Path) const
+{
+	FScopeLock ScopeLock(&Lock);
+	if (const ultralight::RefPtr<ultralight::FontFile>* Existing = OpenFiles.Find(Path))
+	{
+		return *Existing;
+	}
+
+	const ultralight::RefPtr<ultralight::Buffer> Data = FileSystem.OpenFile(ToUltralightString(Path));
+	if (!Data)
+	{
+		UE_LOG(LogUltralightUE, Warning, TEXT("Font %s is in the font index but could not be opened"), *Path);
+		return nullptr;
+	}
+
+	ultralight::RefPtr<ultralight::FontFile> File = ultralight::AdoptRef(*new FULUEFontFile(Data, FCrc::StrCrc32(*Path)));
+	OpenFiles.Add(Path, File);
+	return File;
+}
+
+ultralight::FontLoader* ULUEFontLoader::GetPlatformLoader() const
+{
+	if (!CVarSystemFonts.GetValueOnAnyThread())
+	{
+		return nullptr;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (!PlatformLoader)
+	{
+		PlatformLoader = ultralight::GetPlatformFontLoader();
+	}
+	return PlatformLoader;
+}
+
+ultralight::String ULUEFontLoader::fallback_font() const
+{
+	const FString Configured = CVarDefaultFontFamily.GetValueOnAnyThread();
+	if (!Configured.IsEmpty())
+	{
+		return ToUltralightString(Configured);
+	}
+	if (ultralight::FontLoader* Platform = GetPlatformLoader())
+	{
+		return Platform->fallback_font();
+	}
+	return ToUltralightString(DefaultFamily);
+}
+
+ultralight::String ULUEFontLoader::fallback_font_for_characters(const ultralight::String& characters, int weight, bool italic) const
+{
+	const uint32 Codepoint = GetFallbackCodepoint(characters);
+	// Unicode block (21-bit code point >> 8), weight bucket and italic.
+	const uint32 Key = (Codepoint >> 8) << 5 | static_cast<uint32>(FMath::Clamp(weight / 100, 0, 10)) << 1 | (italic ? 1u : 0u);
+
+	{
+		FReadScopeLock ScopeLock(FallbackLock);
+		const FFallbackEntry* Entry = FallbackCache.Find(Key);
+		// Blocks can straddle a project font's coverage; only trust project answers that cover this character.
+		if (Entry && (Entry->FamilyIndex == INDEX_NONE || Covers(FallbackFamilies[Entry->FamilyIndex], Codepoint)))
+		{
+			INC_DWORD_STAT(STAT_UltralightFontFallbackHits);
+			GFallbackHits.fetch_add(1, std::memory_order_relaxed);
+			return Entry->Name;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_UltralightFontFallbackMisses);
+	GFallbackMisses.fetch_add(1, std::memory_order_relaxed);
+
+	FFallbackEntry Entry = ResolveFallback(characters, Codepoint, weight, italic);
+	const ultralight::String Name = Entry.Name;
+	FWriteScopeLock ScopeLock(FallbackLock);
+	FallbackCache.Add(Key, MoveTemp(Entry));
+	return Name;
+}
+
+ULUEFontLoader::FFallbackEntry ULUEFontLoader::ResolveFallback(const ultralight::String& Characters, uint32 Codepoint, int32 Weight, bool bItalic) const
+{
+	std::call_once(FallbackFamiliesOnce, [this]() { BuildFallbackFamilies(); });
+
+	FFallbackEntry Entry;
+	for (int32 Index = 0; Index < FallbackFamilies.Num(); ++Index)
+	{
+		if (Covers(FallbackFamilies[Index], Codepoint))
+		{
+			Entry.Name = FallbackFamilies[Index].Name;
+			Entry.FamilyIndex = Index;
+			return Entry;
+		}
+	}
+
+	if (ultralight::FontLoader* Platform = GetPlatformLoader())
+	{
+		Entry.Name = Platform->fallback_font_for_characters(Characters, Weight, bItalic);
+	}
+	else
+	{
+		Entry.Name = fallback_font();
+	}
+	return Entry;
+}
+
+void ULUEFontLoader::BuildFallbackFamilies() const
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FString> FamilyKeys;
+	Families.GetKeys(FamilyKeys);
+	FamilyKeys.Sort();
+
+	// The configured or default family wins whenever it covers the character.
+	const FString Preferred = CVarDefaultFontFamily.GetValueOnAnyThread().IsEmpty() ? DefaultFamily : CVarDefaultFontFamily.GetValueOnAnyThread();
+	const int32 PreferredIndex = FamilyKeys.IndexOfByKey(Preferred.ToLower());
+	if (PreferredIndex > 0)
+	{
+		FamilyKeys.Swap(0, PreferredIndex);
+	}
+
+	for (const FString& FamilyKey : FamilyKeys)
+	{
+		const FULUEFontFace* Face = FindFace(FamilyKey, 400, false);
+		const ultralight::RefPtr<ultralight::FontFile> File = Face ? GetFontFile(Face->Path) : nullptr;
+		const ultralight::RefPtr<ultralight::Buffer> Data = File ? File->buffer() : nullptr;
+
+		FFallbackFamily Family;
+		if (Data && ParseFontCoverage(TConstArrayView<uint8>(static_cast<const uint8*>(Data->data()), static_cast<int32>(Data->size())), Family.Coverage))
+		{
+			Family.Name = ToUltralightString(Face->Family);
+			FallbackFamilies.Add(MoveTemp(Family));
+		}
+	}
+
+	UE_LOG(LogUltralightUE, Log, TEXT("Ultralight font fallback: coverage of %d families read in %.2f ms"),
+		FallbackFamilies.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool ULUEFontLoader::Covers(const FFallbackFamily& Family, uint32 Codepoint)
+{
+	const int32 Index = Algo::UpperBoundBy(Family.Coverage, Codepoint, &FULUECodepointRange::First) - 1;
+	return Index >= 0 && Codepoint <= Family.Coverage[Index].Last;
+}
+
+ultralight::RefPtr<ultralight::FontFile> ULUEFontLoader::Load(const ultralight::String& family, int weight, bool italic)
+{
+	if (const FULUEFontFace* Face = FindFace(ToFString(family), weight, italic))
+	{
+		if (ultralight::RefPtr<ultralight::FontFile> File = GetFontFile(Face->Path))
+		{
+			return File;
+		}
+	}
+
+	if (ultralight::FontLoader* Platform = GetPlatformLoader())
+	{
+		return Platform->Load(family, weight, italic);
+	}
+	return nullptr;
+}
+
+} // namespace ultralightue
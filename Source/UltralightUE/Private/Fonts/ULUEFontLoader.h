@@ -0,0 +1,131 @@
+/*
+ * Font loader for Ultralight.
+ * Serves font families shipped under uicontent/fonts from memory, through ULUEFileSystem, so they are
+ * read from the pak or UI bundle like any other UI file. System fonts are only consulted for families the
+ * project doesn't ship.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ULUEUltralightIncludes.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeRWLock.h"
+#include <mutex>
+
+namespace ultralightue
+{
+
+class ULUEFileSystem;
+
+/** One face in the font index: a family/weight/style and the file that provides it. */
+struct FULUEFontFace
+{
+	FString Family;
+	int32 Weight = 400;
+	bool bItalic = false;
+	/// Path as Ultralight sees it, e.g. "fonts/Inter-Bold.ttf".
+	FString Path;
+};
+
+/** Inclusive range of Unicode code points. */
+struct FULUECodepointRange
+{
+	uint32 First = 0;
+	uint32 Last = 0;
+};
+
+/**
+ * Reads the family name, weight class and italic flag of the first face in a TrueType/OpenType file (or collection).
+ * Only the table directory, 'name', 'OS/2' and 'head' are touched. Returns false for anything it can't parse.
+ */
+bool ParseFontFace(TConstArrayView<uint8> Data, FULUEFontFace& OutFace);
+
+/**
+ * Code points the first face of a font file maps to glyphs ('cmap' formats 4 and 12), sorted and merged.
+ * Returns false if the file has no usable Unicode cmap.
+ */
+bool ParseFontCoverage(TConstArrayView<uint8> Data, TArray<FULUECodepointRange>& OutRanges);
+
+/**
+ * Scans ContentDirectory/fonts for .ttf/.otf/.ttc files and writes the index the loader reads at startup
+ * (fonts/fontindex.txt). Run by the UltralightBundle commandlet; returns the number of faces.
+ */
+int32 WriteFontIndex(const FString& ContentDirectory);
+
+/**
+ * ultralight::FontLoader over the project's fonts.
+ *
+ * Family/weight/italic lookups resolve through a table read once from fonts/fontindex.txt, plus any font file
+ * the index doesn't list, parsed once. Each font file is opened once and its FontFile kept for
+ * the loader's lifetime, so every view shares one in-memory buffer per file.
+ *
+ * Fallback for characters the page's fonts lack goes through a cache keyed by Unicode block (which stands in for
+ * the script), weight and italic. Misses consult the project families' cmap coverage, built once on first use,
+ * before asking the platform. Thread-safe.
+ */
+class ULUEFontLoader : public ultralight::FontLoader
+{
+public:
+	explicit ULUEFontLoader(ULUEFileSystem& InFileSystem);
+	virtual ~ULUEFontLoader() override;
+
+	//~ Begin ultralight::FontLoader Interface
+	virtual ultralight::String fallback_font() const override;
+	virtual ultralight::String fallback_font_for_characters(const ultralight::String& characters, int weight, bool italic) const override;
+	virtual ultralight::RefPtr<ultralight::FontFile> Load(const ultralight::String& family, int weight, bool italic) override;
+	//~ End ultralight::FontLoader Interface
+
+	int32 GetNumFaces() const { return NumFaces; }
+
+private:
+	void LoadIndex();
+	/// Parses font files that aren't in the index (all of them when there is none).
+	void AddUnindexedFaces();
+	void AddFace(FULUEFontFace&& Face);
+
+	/// Closest face per CSS font matching: style first, then weight (lighter or heavier depending on the request).
+	const FULUEFontFace* FindFace(const FString& Family, int32 Weight, bool bItalic) const;
+
+	/// The FontFile for Path, opened on first use and shared afterwards.
+	ultralight::RefPtr<ultralight::FontFile> GetFontFile(const FString& Path) const;
+
+	struct FFallbackFamily
+	{
+		ultralight::String Name;
+		TArray<FULUECodepointRange> Coverage;
+	};
+
+	struct FFallbackEntry
+	{
+		ultralight::String Name;
+		/// Index into FallbackFamilies, or INDEX_NONE for platform and default results.
+		int32 FamilyIndex = INDEX_NONE;
+	};
+
+	/// Reads the coverage of every project family, default family first.
+	void BuildFallbackFamilies() const;
+	FFallbackEntry ResolveFallback(const ultralight::String& Characters, uint32 Codepoint, int32 Weight, bool bItalic) const;
+	static bool Covers(const FFallbackFamily& Family, uint32 Codepoint);
+
+	/// Created on first use, so projects that ship every family they use never scan system fonts.
+	ultralight::FontLoader* GetPlatformLoader() const;
+
+	ULUEFileSystem& FileSystem;
+
+	/// Lowercase family -> faces. Built once, read-only afterwards.
+	TMap<FString, TArray<FULUEFontFace>> Families;
+	FString DefaultFamily;
+	int32 NumFaces = 0;
+
+	mutable FCriticalSection Lock;
+	mutable TMap<FString, ultralight::RefPtr<ultralight::FontFile>> OpenFiles;
+	mutable ultralight::FontLoader* PlatformLoader = nullptr;
+
+	mutable std::once_flag FallbackFamiliesOnce;
+	mutable TArray<FFallbackFamily> FallbackFamilies;
+	mutable FRWLock FallbackLock;
+	mutable TMap<uint32, FFallbackEntry> FallbackCache;
+};
+
+} // namespace ultralightue
@@ -1,7 +1,5 @@
 #include "ULUEILoggerInterface.h"
-
-// Define the log category
-DEFINE_LOG_CATEGORY(LogUltralightUE);
+#include "ULUETrace.h"
 
 namespace ultralightue
 {
@@ -9,6 +7,9 @@ namespace ultralightue
     {
         // Convert Ultralight string to FString - use utf8().data() as c_str() no longer exists in SDK 1.4
         FString MessageStr = FString(UTF8_TO_TCHAR(message.utf8().data()));
+
+        // Mirror into the trace so Insights shows the message next to the view/stage that produced it.
+        TraceLogMessage(static_cast<uint8>(log_level), MessageStr);
         
         // Log the message using the Unreal Engine logging system
         switch (log_level)
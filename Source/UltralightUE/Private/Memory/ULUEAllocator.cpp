@@ -0,0 +1,208 @@
+/*
+ * Routes Ultralight's heap (ULAllocator) through FMemory under an LLM tag.
+ */
+
+#include "Memory/ULUEAllocator.h"
+#include "ULUELogInterface.h"
+#include "ULUEStats.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+#include <Ultralight/platform/Allocator.h>
+
+LLM_DEFINE_TAG(Ultralight);
+
+namespace ultralightue
+{
+	namespace
+	{
+		struct FCategoryCounters
+		{
+			std::atomic<int64> LiveBytes{ 0 };
+			std::atomic<int64> PeakBytes{ 0 };
+			std::atomic<int64> LiveAllocations{ 0 };
+		};
+
+		FCategoryCounters GCounters[static_cast<int32>(EULUEAllocCategory::Num)];
+		bool GAllocatorInstalled = false;
+
+		void UpdatePeak(std::atomic<int64>& Peak, int64 Value)
+		{
+			int64 Current = Peak.load(std::memory_order_relaxed);
+			while (Value > Current && !Peak.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		// Sizes come from FMemory::GetAllocSize so frees don't need a header; binned allocators
+		// report the size-class size, which is what the allocation really costs.
+		void OnAllocated(EULUEAllocCategory Category, void* Address)
+		{
+			if (!Address)
+			{
+				return;
+			}
+			FCategoryCounters& Counters = GCounters[static_cast<int32>(Category)];
+			const int64 Size = static_cast<int64>(FMemory::GetAllocSize(Address));
+			const int64 Live = Counters.LiveBytes.fetch_add(Size, std::memory_order_relaxed) + Size;
+			Counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+			UpdatePeak(Counters.PeakBytes, Live);
+		}
+
+		void OnFreed(EULUEAllocCategory Category, int64 Size)
+		{
+			FCategoryCounters& Counters = GCounters[static_cast<int32>(Category)];
+			Counters.LiveBytes.fetch_sub(Size, std::memory_order_relaxed);
+			Counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void OnFreeing(EULUEAllocCategory Category, void* Address)
+		{
+			if (Address)
+			{
+				OnFreed(Category, static_cast<int64>(FMemory::GetAllocSize(Address)));
+			}
+		}
+
+		// OldSize is read before reallocating. A null result for a non-zero size is a failed realloc that
+		// leaves the old block live, so nothing changes; Realloc(p, 0) frees p and also returns null.
+		void OnReallocated(EULUEAllocCategory Category, void* OldAddress, int64 OldSize, void* NewAddress, size_t Bytes)
+		{
+			if (!NewAddress && Bytes != 0)
+			{
+				return;
+			}
+			if (OldAddress)
+			{
+				OnFreed(Category, OldSize);
+			}
+			OnAllocated(Category, NewAddress);
+		}
+
+		void* ULMalloc(size_t Bytes)
+		{
+			LLM_SCOPE_BYTAG(Ultralight);
+			void* Result = FMemory::Malloc(Bytes);
+			OnAllocated(EULUEAllocCategory::Heap, Result);
+			return Result;
+		}
+
+		void* ULRealloc(void* Address, size_t Bytes)
+		{
+			LLM_SCOPE_BYTAG(Ultralight);
+			const int64 OldSize = Address ? static_cast<int64>(FMemory::GetAllocSize(Address)) : 0;
+			void* Result = FMemory::Realloc(Address, Bytes);
+			OnReallocated(EULUEAllocCategory::Heap, Address, OldSize, Result, Bytes);
+			return Result;
+		}
+
+		void ULFree(void* Address)
+		{
+			OnFreeing(EULUEAllocCategory::Heap, Address);
+			FMemory::Free(Address);
+		}
+
+		void* ULAlignedMalloc(size_t Bytes, size_t Alignment)
+		{
+			LLM_SCOPE_BYTAG(Ultralight);
+			void* Result = FMemory::Malloc(Bytes, static_cast<uint32>(Alignment));
+			OnAllocated(EULUEAllocCategory::Aligned, Result);
+			return Result;
+		}
+
+		void* ULAlignedRealloc(void* Address, size_t Bytes, size_t Alignment)
+		{
+			LLM_SCOPE_BYTAG(Ultralight);
+			const int64 OldSize = Address ? static_cast<int64>(FMemory::GetAllocSize(Address)) : 0;
+			void* Result = FMemory::Realloc(Address, Bytes, static_cast<uint32>(Alignment));
+			OnReallocated(EULUEAllocCategory::Aligned, Address, OldSize, Result, Bytes);
+			return Result;
+		}
+
+		void ULAlignedFree(void* Address)
+		{
+			OnFreeing(EULUEAllocCategory::Aligned, Address);
+			FMemory::Free(Address);
+		}
+
+		size_t ULGetSizeEstimate(void* Address)
+		{
+			return Address ? FMemory::GetAllocSize(Address) : 0;
+		}
+	}
+
+	bool InstallUltralightAllocator(void* UltralightCoreHandle)
+	{
+		if (GAllocatorInstalled)
+		{
+			return true;
+		}
+
+		if (!UltralightCoreHandle || FParse::Param(FCommandLine::Get(), TEXT("UltralightNativeAllocator")))
+		{
+			return false;
+		}
+
+		ULAllocator* Allocator = static_cast<ULAllocator*>(FPlatformProcess::GetDllExport(UltralightCoreHandle, TEXT("ulAllocator")));
+		if (!Allocator)
+		{
+			UE_LOG(LogUltralightUE, Log, TEXT("ulAllocator not exported (SDK built without UL_ENABLE_ALLOCATOR_OVERRIDE); Ultralight memory will not be tracked by LLM"));
+			return false;
+		}
+
+		Allocator->malloc = &ULMalloc;
+		Allocator->realloc = &ULRealloc;
+		Allocator->free = &ULFree;
+		Allocator->aligned_malloc = &ULAlignedMalloc;
+		Allocator->aligned_realloc = &ULAlignedRealloc;
+		Allocator->aligned_free = &ULAlignedFree;
+		Allocator->get_size_estimate = &ULGetSizeEstimate;
+		GAllocatorInstalled = true;
+
+		UE_LOG(LogUltralightUE, Log, TEXT("Ultralight allocations routed through FMemory (LLM tag: Ultralight)"));
+		return true;
+	}
+
+	bool IsUltralightAllocatorInstalled()
+	{
+		return GAllocatorInstalled;
+	}
+
+	FULUEAllocatorStats GetUltralightAllocatorStats(EULUEAllocCategory Category)
+	{
+		FULUEAllocatorStats Stats;
+		for (int32 Index = 0; Index < static_cast<int32>(EULUEAllocCategory::Num); ++Index)
+		{
+			if (Category != EULUEAllocCategory::Num && Index != static_cast<int32>(Category))
+			{
+				continue;
+			}
+			const FCategoryCounters& Counters = GCounters[Index];
+			Stats.LiveBytes += Counters.LiveBytes.load(std::memory_order_relaxed);
+			Stats.PeakBytes += Counters.PeakBytes.load(std::memory_order_relaxed);
+			Stats.LiveAllocations += Counters.LiveAllocations.load(std::memory_order_relaxed);
+		}
+		return Stats;
+	}
+
+	void PublishUltralightAllocatorStats()
+	{
+		if (!GAllocatorInstalled)
+		{
+			return;
+		}
+
+		const FULUEAllocatorStats Heap = GetUltralightAllocatorStats(EULUEAllocCategory::Heap);
+		const FULUEAllocatorStats Aligned = GetUltralightAllocatorStats(EULUEAllocCategory::Aligned);
+		SET_MEMORY_STAT(STAT_UltralightHeapMemory, Heap.LiveBytes);
+		SET_MEMORY_STAT(STAT_UltralightHeapPeakMemory, Heap.PeakBytes);
+		SET_MEMORY_STAT(STAT_UltralightAlignedMemory, Aligned.LiveBytes);
+		SET_MEMORY_STAT(STAT_UltralightAlignedPeakMemory, Aligned.PeakBytes);
+		SET_DWORD_STAT(STAT_UltralightLiveAllocations, Heap.LiveAllocations + Aligned.LiveAllocations);
+
+#if CSV_PROFILER
+		constexpr double BytesToMB = 1.0 / (1024.0 * 1024.0);
+		CSV_CUSTOM_STAT(Ultralight, LibraryHeapMB, static_cast<float>(Heap.LiveBytes * BytesToMB), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Ultralight, LibraryAlignedMB, static_cast<float>(Aligned.LiveBytes * BytesToMB), ECsvCustomStatOp::Set);
+#endif
+	}
+}
@@ -0,0 +1,45 @@
+/*
+ * Routes Ultralight's heap (ULAllocator) through FMemory under an LLM tag.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+LLM_DECLARE_TAG(Ultralight);
+
+namespace ultralightue
+{
+	/// Allocation families tracked separately; matches the two ULAllocator function groups.
+	enum class EULUEAllocCategory : uint8
+	{
+		Heap,    /// malloc / realloc / free
+		Aligned, /// aligned_malloc / aligned_realloc / aligned_free
+		Num
+	};
+
+	struct FULUEAllocatorStats
+	{
+		int64 LiveBytes = 0;
+		int64 PeakBytes = 0;
+		int64 LiveAllocations = 0;
+	};
+
+	/// @brief Points the library's ulAllocator at FMemory. Must run after UltralightCore is loaded
+	/// and before any other Ultralight call.
+	/// Only Pro builds compiled with UL_ENABLE_ALLOCATOR_OVERRIDE export ulAllocator; otherwise this
+	/// logs and returns false, and Ultralight keeps its own heap.
+	/// @param UltralightCoreHandle DLL handle of UltralightCore (the module that exports ulAllocator).
+	bool InstallUltralightAllocator(void* UltralightCoreHandle);
+
+	/// @brief True if InstallUltralightAllocator succeeded.
+	bool IsUltralightAllocatorInstalled();
+
+	/// @brief Live and peak bytes for one category (or the total when Category is Num).
+	FULUEAllocatorStats GetUltralightAllocatorStats(EULUEAllocCategory Category = EULUEAllocCategory::Num);
+
+	/// @brief Copies the allocator counters into `stat Ultralight` and the CSV profiler. Called once per tick;
+	/// the per-allocation path only touches atomics.
+	void PublishUltralightAllocatorStats();
+}
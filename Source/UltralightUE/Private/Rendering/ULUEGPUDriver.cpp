@@ -0,0 +1,659 @@
+/*
+ * RDG-backed GPU driver for accelerated Ultralight views.
+ */
+
+#include "Rendering/ULUEGPUDriver.h"
+#include "ULUEShaders.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderTargetPool.h"
+#include "RenderingThread.h"
+#include "RHIStaticStates.h"
+#include "RenderUtils.h"
+#include "TextureResource.h"
+#include "Async/ParallelFor.h"
+#include "ULUEStats.h"
+
+namespace ultralightue
+{
+
+BEGIN_SHADER_PARAMETER_STRUCT(FULUEBatchPassParameters, )
+	RDG_TEXTURE_ACCESS_ARRAY(Textures)
+	RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+namespace
+{
+	/// Fully translated draw, ready to be recorded without touching Ultralight state.
+	struct FULUEDrawCall
+	{
+		EULUEShaderProgram Program = EULUEShaderProgram::Fill;
+		bool bEnableBlend = true;
+		bool bEnableScissor = false;
+		FIntRect ScissorRect;
+		FIntPoint ViewportSize = FIntPoint::ZeroValue;
+		FULUEShaderUniforms Uniforms;
+		uint32 Texture0Id = 0;
+		uint32 Texture1Id = 0;
+		FBufferRHIRef VertexBuffer;
+		FBufferRHIRef IndexBuffer;
+		uint32 NumVertices = 0;
+		uint32 FirstIndex = 0;
+		uint32 NumPrimitives = 0;
+	};
+
+	/// A contiguous run of commands targeting one render buffer; becomes a single RDG raster pass.
+	struct FULUECommandBatch
+	{
+		uint32 RenderBufferId = 0;
+		bool bClear = false;
+		int32 FirstCommand = 0;
+		int32 NumCommands = 0;
+		TArray<FULUEDrawCall> Draws;
+	};
+
+	/// Ultralight matrices are column-major; UE shaders read row-major, so transpose on upload.
+	FMatrix44f ToShaderMatrix(const ultralight::Matrix4x4& Matrix)
+	{
+		FMatrix44f Result;
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			for (int32 Col = 0; Col < 4; ++Col)
+			{
+				Result.M[Row][Col] = Matrix.data[Col * 4 + Row];
+			}
+		}
+		return Result;
+	}
+
+	void BuildUniforms(const ultralight::GPUState& State, FULUEShaderUniforms& OutUniforms)
+	{
+		OutUniforms.State = FVector4f(0.0f, static_cast<float>(State.viewport_width), static_cast<float>(State.viewport_height), 1.0f);
+
+		ultralight::Matrix Transform;
+		Transform.Set(State.transform);
+		ultralight::Matrix Projection;
+		Projection.SetOrthographicProjection(State.viewport_width, State.viewport_height, false);
+		Projection.Transform(Transform);
+		OutUniforms.Transform = ToShaderMatrix(Projection.GetMatrix4x4());
+
+		OutUniforms.Scalar4[0] = FVector4f(State.uniform_scalar[0], State.uniform_scalar[1], State.uniform_scalar[2], State.uniform_scalar[3]);
+		OutUniforms.Scalar4[1] = FVector4f(State.uniform_scalar[4], State.uniform_scalar[5], State.uniform_scalar[6], State.uniform_scalar[7]);
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			const ultralight::vec4& Vector = State.uniform_vector[Index];
+			OutUniforms.Vector[Index] = FVector4f(Vector.x, Vector.y, Vector.z, Vector.w);
+		}
+
+		OutUniforms.ClipSize = FMath::Min<uint32>(State.clip_size, 8);
+		for (uint32 Index = 0; Index < OutUniforms.ClipSize; ++Index)
+		{
+			OutUniforms.Clip[Index] = ToShaderMatrix(State.clip[Index]);
+		}
+	}
+
+	/// Copies bitmap pixels out on the game thread; Ultralight may reuse the bitmap right after the call.
+	TArray<uint8> CopyBitmapPixels(const ultralight::RefPtr<ultralight::Bitmap>& Bitmap, uint32& OutRowBytes)
+	{
+		TArray<uint8> Pixels;
+		OutRowBytes = Bitmap->row_bytes();
+		if (Bitmap->IsEmpty())
+		{
+			return Pixels;
+		}
+
+		const void* Source = Bitmap->LockPixels();
+		if (Source)
+		{
+			Pixels.SetNumUninitialized(static_cast<int32>(Bitmap->size()));
+			FMemory::Memcpy(Pixels.GetData(), Source, Pixels.Num());
+		}
+		Bitmap->UnlockPixels();
+		return Pixels;
+	}
+
+	void UploadBuffer(FRHICommandListBase& RHICmdList, FBufferRHIRef& Buffer, uint32& Capacity, const TArray<uint8>& Data, bool bIndexBuffer)
+	{
+		if (Data.Num() == 0)
+		{
+			return;
+		}
+
+		if (!Buffer.IsValid() || Capacity < static_cast<uint32>(Data.Num()))
+		{
+			FRHIResourceCreateInfo CreateInfo(bIndexBuffer ? TEXT("UltralightIndexBuffer") : TEXT("UltralightVertexBuffer"));
+			Buffer = bIndexBuffer
+				? RHICmdList.CreateIndexBuffer(sizeof(ultralight::IndexType), Data.Num(), BUF_Dynamic, CreateInfo)
+				: RHICmdList.CreateVertexBuffer(Data.Num(), BUF_Dynamic, CreateInfo);
+			Capacity = Data.Num();
+		}
+
+		void* Dest = RHICmdList.LockBuffer(Buffer, 0, Data.Num(), RLM_WriteOnly);
+		FMemory::Memcpy(Dest, Data.GetData(), Data.Num());
+		RHICmdList.UnlockBuffer(Buffer);
+	}
+
+	void EnqueueGeometryUpload(const TSharedRef<FULUEGPUResources, ESPMode::ThreadSafe>& Resources, uint32 GeometryId, const ultralight::VertexBuffer& Vertices, const ultralight::IndexBuffer& Indices)
+	{
+		const uint32 Stride = Vertices.format == ultralight::VertexBufferFormat::_2f_4ub_2f
+			? sizeof(ultralight::Vertex_2f_4ub_2f)
+			: sizeof(ultralight::Vertex_2f_4ub_2f_2f_28f);
+
+		TArray<uint8> VertexData(Vertices.data, Vertices.size);
+		TArray<uint8> IndexData(Indices.data, Indices.size);
+
+		ENQUEUE_RENDER_COMMAND(ULUEUploadGeometry)(
+			[Resources, GeometryId, Stride, VertexData = MoveTemp(VertexData), IndexData = MoveTemp(IndexData)](FRHICommandListImmediate& RHICmdList)
+			{
+				ULUE_SCOPE_CYCLE_COUNTER(Upload);
+				FULUEGPUResources::FGeometry& Geometry = Resources->Geometry.FindOrAdd(GeometryId);
+				UploadBuffer(RHICmdList, Geometry.VertexBuffer, Geometry.VertexBufferSize, VertexData, false);
+				UploadBuffer(RHICmdList, Geometry.IndexBuffer, Geometry.IndexBufferSize, IndexData, true);
+				Geometry.NumVertices = VertexData.Num() / Stride;
+			});
+	}
+
+	/// Splits the frame's commands into per-render-buffer batches, preserving submission order.
+	TArray<FULUECommandBatch> BuildBatches(const TArray<ultralight::Command>& Commands)
+	{
+		TArray<FULUECommandBatch> Batches;
+		for (int32 Index = 0; Index < Commands.Num(); ++Index)
+		{
+			const ultralight::Command& Command = Commands[Index];
+			const uint32 RenderBufferId = Command.gpu_state.render_buffer_id;
+			const bool bClear = Command.command_type == ultralight::CommandType::ClearRenderBuffer;
+
+			// A clear always starts a new pass so it can become the pass load action.
+			if (bClear || Batches.Num() == 0 || Batches.Last().RenderBufferId != RenderBufferId)
+			{
+				FULUECommandBatch& Batch = Batches.AddDefaulted_GetRef();
+				Batch.RenderBufferId = RenderBufferId;
+				Batch.bClear = bClear;
+				Batch.FirstCommand = Index;
+			}
+			++Batches.Last().NumCommands;
+		}
+		return Batches;
+	}
+
+	void TranslateBatch(const FULUEGPUResources& Resources, const TArray<ultralight::Command>& Commands, FULUECommandBatch& Batch)
+	{
+		Batch.Draws.Reserve(Batch.NumCommands);
+		for (int32 Index = Batch.FirstCommand; Index < Batch.FirstCommand + Batch.NumCommands; ++Index)
+		{
+			const ultralight::Command& Command = Commands[Index];
+			if (Command.command_type != ultralight::CommandType::DrawGeometry)
+			{
+				continue;
+			}
+
+			const FULUEGPUResources::FGeometry* Geometry = Resources.Geometry.Find(Command.geometry_id);
+			if (!Geometry || !Geometry->VertexBuffer.IsValid() || !Geometry->IndexBuffer.IsValid())
+			{
+				continue;
+			}
+
+			const ultralight::GPUState& State = Command.gpu_state;
+			FULUEDrawCall& Draw = Batch.Draws.AddDefaulted_GetRef();
+			Draw.Program = State.shader_type == ultralight::ShaderType::Fill ? EULUEShaderProgram::Fill : EULUEShaderProgram::FillPath;
+			Draw.bEnableBlend = State.enable_blend;
+			Draw.bEnableScissor = State.enable_scissor;
+			Draw.ScissorRect = FIntRect(State.scissor_rect.left, State.scissor_rect.top, State.scissor_rect.right, State.scissor_rect.bottom);
+			Draw.ViewportSize = FIntPoint(State.viewport_width, State.viewport_height);
+			BuildUniforms(State, Draw.Uniforms);
+			if (State.enable_texturing)
+			{
+				Draw.Texture0Id = State.texture_1_id;
+				Draw.Texture1Id = State.texture_2_id;
+			}
+			Draw.VertexBuffer = Geometry->VertexBuffer;
+			Draw.IndexBuffer = Geometry->IndexBuffer;
+			Draw.NumVertices = Geometry->NumVertices;
+			Draw.FirstIndex = Command.indices_offset;
+			Draw.NumPrimitives = Command.indices_count / 3;
+		}
+	}
+
+	/// Frames a timestamp pair may stay unresolved before it is dropped.
+	constexpr uint64 MaxTimingLatencyFrames = 8;
+
+	/// Reads back finished timestamp pairs without stalling and publishes per-render-buffer GPU times.
+	void ReadBackTimings(FULUEGPUResources& Resources)
+	{
+		TMap<uint32, TPair<uint64, uint64>> Finished;
+		for (int32 Index = Resources.PendingTimings.Num() - 1; Index >= 0; --Index)
+		{
+			FULUEGPUResources::FPendingTiming& Timing = Resources.PendingTimings[Index];
+			uint64 BeginMicroseconds = 0;
+			uint64 EndMicroseconds = 0;
+			const bool bReady = RHIGetRenderQueryResult(Timing.Begin.GetQuery(), BeginMicroseconds, false)
+				&& RHIGetRenderQueryResult(Timing.End.GetQuery(), EndMicroseconds, false);
+			if (bReady)
+			{
+				TPair<uint64, uint64>& Entry = Finished.FindOrAdd(Timing.RenderBufferId, TPair<uint64, uint64>(Timing.Frame, 0));
+				if (Timing.Frame > Entry.Key)
+				{
+					Entry = TPair<uint64, uint64>(Timing.Frame, 0);
+				}
+				if (Timing.Frame == Entry.Key && EndMicroseconds > BeginMicroseconds)
+				{
+					Entry.Value += EndMicroseconds - BeginMicroseconds;
+				}
+			}
+
+			if (bReady || Timing.Frame + MaxTimingLatencyFrames < Resources.SubmittedFrames)
+			{
+				Resources.PendingTimings.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			}
+		}
+
+		if (Finished.Num() > 0)
+		{
+			FScopeLock Lock(&Resources.GPUTimesLock);
+			for (const TPair<uint32, TPair<uint64, uint64>>& Entry : Finished)
+			{
+				TPair<uint64, uint64>& Published = Resources.GPUTimes.FindOrAdd(Entry.Key, Entry.Value);
+				if (Entry.Value.Key >= Published.Key)
+				{
+					Published = Entry.Value;
+				}
+			}
+		}
+	}
+
+	void ExecuteCommandLists(FRDGBuilder& GraphBuilder, FULUEGPUResources& Resources, const TArray<ultralight::Command>& Commands, const TArray<FULUEResolveRequest>& Resolves, const TMap<uint32, FString>& RenderBufferNames)
+	{
+		++Resources.SubmittedFrames;
+		const bool bTimestamps = GSupportsTimestampRenderQueries;
+		if (bTimestamps)
+		{
+			ReadBackTimings(Resources);
+			if (!Resources.TimestampQueryPool.IsValid())
+			{
+				Resources.TimestampQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime);
+			}
+		}
+
+		FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+		TMap<uint32, FRDGTextureRef> GraphTextures;
+		auto GetGraphTexture = [&](uint32 TextureId) -> FRDGTextureRef
+		{
+			if (FRDGTextureRef* Existing = GraphTextures.Find(TextureId))
+			{
+				return *Existing;
+			}
+			const TRefCountPtr<IPooledRenderTarget>* Pooled = Resources.Textures.Find(TextureId);
+			FRDGTextureRef Texture = Pooled ? GraphBuilder.RegisterExternalTexture(*Pooled) : nullptr;
+			GraphTextures.Add(TextureId, Texture);
+			return Texture;
+		};
+
+		TArray<FULUECommandBatch> Batches = BuildBatches(Commands);
+
+		// Command translation (projection, uniforms, geometry lookup) is independent per batch.
+		ParallelFor(Batches.Num(), [&](int32 BatchIndex)
+		{
+			TranslateBatch(Resources, Commands, Batches[BatchIndex]);
+		});
+
+		FRDGTextureRef DummyTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(GBlackTexture->TextureRHI, TEXT("UltralightBlackDummy")));
+		FRHISamplerState* Sampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+		for (FULUECommandBatch& Batch : Batches)
+		{
+			const uint32* RenderTextureId = Resources.RenderBufferTextures.Find(Batch.RenderBufferId);
+			FRDGTextureRef RenderTexture = RenderTextureId ? GetGraphTexture(*RenderTextureId) : nullptr;
+			if (!RenderTexture || (!Batch.bClear && Batch.Draws.Num() == 0))
+			{
+				continue;
+			}
+
+			FULUEBatchPassParameters* PassParameters = GraphBuilder.AllocParameters<FULUEBatchPassParameters>();
+			PassParameters->RenderTargets[0] = FRenderTargetBinding(RenderTexture, Batch.bClear ? ERenderTargetLoadAction::EClear : ERenderTargetLoadAction::ELoad);
+
+			// Resolve sampled textures up front so RDG can order this pass against the passes that wrote them.
+			struct FResolvedTextures { FRDGTextureRef Texture0; FRDGTextureRef Texture1; };
+			TArray<FResolvedTextures> DrawTextures;
+			DrawTextures.Reserve(Batch.Draws.Num());
+			for (const FULUEDrawCall& Draw : Batch.Draws)
+			{
+				FResolvedTextures& Resolved = DrawTextures.AddDefaulted_GetRef();
+				Resolved.Texture0 = Draw.Texture0Id ? GetGraphTexture(Draw.Texture0Id) : nullptr;
+				Resolved.Texture1 = Draw.Texture1Id ? GetGraphTexture(Draw.Texture1Id) : nullptr;
+				for (FRDGTextureRef Texture : { Resolved.Texture0, Resolved.Texture1 })
+				{
+					if (Texture && Texture != RenderTexture)
+					{
+						PassParameters->Textures.AddUnique(FRDGTextureAccess(Texture, ERHIAccess::SRVGraphics));
+					}
+				}
+				Resolved.Texture0 = Resolved.Texture0 ? Resolved.Texture0 : DummyTexture;
+				Resolved.Texture1 = Resolved.Texture1 ? Resolved.Texture1 : DummyTexture;
+			}
+			PassParameters->Textures.AddUnique(FRDGTextureAccess(DummyTexture, ERHIAccess::SRVGraphics));
+
+			// Bracket the pass with timestamps so the owning view can report its GPU cost.
+			FRHIRenderQuery* BeginQuery = nullptr;
+			FRHIRenderQuery* EndQuery = nullptr;
+			if (bTimestamps)
+			{
+				FULUEGPUResources::FPendingTiming& Timing = Resources.PendingTimings.AddDefaulted_GetRef();
+				Timing.Frame = Resources.SubmittedFrames;
+				Timing.RenderBufferId = Batch.RenderBufferId;
+				Timing.Begin = Resources.TimestampQueryPool->AllocateQuery();
+				Timing.End = Resources.TimestampQueryPool->AllocateQuery();
+				BeginQuery = Timing.Begin.GetQuery();
+				EndQuery = Timing.End.GetQuery();
+			}
+
+			const FString* Name = RenderBufferNames.Find(Batch.RenderBufferId);
+
+			// Raster passes without NeverParallel are recorded on RDG's parallel command lists.
+			GraphBuilder.AddPass(
+				RDG_EVENT_NAME("Ultralight %s (%d draws)", Name ? **Name : TEXT("<unnamed>"), Batch.Draws.Num()),
+				PassParameters,
+				ERDGPassFlags::Raster,
+				[ShaderMap, Sampler, BeginQuery, EndQuery, Draws = MoveTemp(Batch.Draws), DrawTextures = MoveTemp(DrawTextures)](FRHICommandList& RHICmdList)
+				{
+					if (BeginQuery)
+					{
+						RHICmdList.EndRenderQuery(BeginQuery);
+					}
+
+					for (int32 DrawIndex = 0; DrawIndex < Draws.Num(); ++DrawIndex)
+					{
+						const FULUEDrawCall& Draw = Draws[DrawIndex];
+						RHICmdList.SetViewport(0.0f, 0.0f, 0.0f, Draw.ViewportSize.X, Draw.ViewportSize.Y, 1.0f);
+						if (Draw.bEnableScissor)
+						{
+							RHICmdList.SetScissorRect(true, Draw.ScissorRect.Min.X, Draw.ScissorRect.Min.Y, Draw.ScissorRect.Max.X, Draw.ScissorRect.Max.Y);
+						}
+						else
+						{
+							RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
+						}
+
+						FGraphicsPipelineStateInitializer GraphicsPSOInit;
+						SetupGraphicsPipelineState(GraphicsPSOInit, ShaderMap, Draw.Program, Draw.bEnableBlend);
+						SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit, 0);
+
+						if (Draw.Program == EULUEShaderProgram::Fill)
+						{
+							TShaderMapRef<FULUEFillVS> VertexShader(ShaderMap);
+							TShaderMapRef<FULUEFillPS> PixelShader(ShaderMap);
+							FULUEFillPS::FParameters PixelParameters;
+							PixelParameters.Uniforms = Draw.Uniforms;
+							PixelParameters.Texture0 = DrawTextures[DrawIndex].Texture0;
+							PixelParameters.Texture1 = DrawTextures[DrawIndex].Texture1;
+							PixelParameters.Sampler0 = Sampler;
+							SetShaderParameters(RHICmdList, VertexShader, VertexShader.GetVertexShader(), Draw.Uniforms);
+							SetShaderParameters(RHICmdList, PixelShader, PixelShader.GetPixelShader(), PixelParameters);
+						}
+						else
+						{
+							TShaderMapRef<FULUEFillPathVS> VertexShader(ShaderMap);
+							TShaderMapRef<FULUEFillPathPS> PixelShader(ShaderMap);
+							SetShaderParameters(RHICmdList, VertexShader, VertexShader.GetVertexShader(), Draw.Uniforms);
+							SetShaderParameters(RHICmdList, PixelShader, PixelShader.GetPixelShader(), Draw.Uniforms);
+						}
+
+						RHICmdList.SetStreamSource(0, Draw.VertexBuffer, 0);
+						RHICmdList.DrawIndexedPrimitive(Draw.IndexBuffer, 0, 0, Draw.NumVertices, Draw.FirstIndex, Draw.NumPrimitives, 1);
+					}
+
+					if (EndQuery)
+					{
+						RHICmdList.EndRenderQuery(EndQuery);
+					}
+				});
+		}
+
+		for (const FULUEResolveRequest& Resolve : Resolves)
+		{
+			FRDGTextureRef Source = GetGraphTexture(Resolve.TextureId);
+			FRHITexture* DestinationRHI = Resolve.Destination ? Resolve.Destination->GetRenderTargetTexture() : nullptr;
+			if (!Source || !DestinationRHI)
+			{
+				continue;
+			}
+
+			FRDGTextureRef Destination = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(DestinationRHI, TEXT("UltralightViewTarget")));
+			const FIntPoint DestinationSize = Destination->Desc.Extent;
+
+			FRHICopyTextureInfo CopyInfo;
+			CopyInfo.SourcePosition = FIntVector(Resolve.SourceRect.Min.X, Resolve.SourceRect.Min.Y, 0);
+			CopyInfo.Size = FIntVector(
+				FMath::Min(Resolve.SourceRect.Width(), DestinationSize.X),
+				FMath::Min(Resolve.SourceRect.Height(), DestinationSize.Y),
+				1);
+			if (CopyInfo.Size.X > 0 && CopyInfo.Size.Y > 0)
+			{
+				AddCopyTexturePass(GraphBuilder, Source, Destination, CopyInfo);
+			}
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              ULUEGPUDriver                                 */
+/* -------------------------------------------------------------------------- */
+
+ULUEGPUDriver::ULUEGPUDriver()
+	: Resources(MakeShared<FULUEGPUResources, ESPMode::ThreadSafe>())
+{
+}
+
+ULUEGPUDriver::~ULUEGPUDriver()
+{
+	// Make sure the RHI resources are released on the render thread, after any in-flight graph.
+	ENQUEUE_RENDER_COMMAND(ULUEReleaseGPUResources)([ReleasedResources = Resources](FRHICommandListImmediate&)
+	{
+		ReleasedResources->Textures.Empty();
+		ReleasedResources->Geometry.Empty();
+		ReleasedResources->RenderBufferTextures.Empty();
+		ReleasedResources->PendingTimings.Empty();
+		ReleasedResources->TimestampQueryPool.SafeRelease();
+	});
+}
+
+void ULUEGPUDriver::CreateTexture(uint32_t texture_id, ultralight::RefPtr<ultralight::Bitmap> bitmap)
+{
+	if (!bitmap)
+	{
+		return;
+	}
+
+	// An empty bitmap means Ultralight wants a render target (it will be bound to a RenderBuffer).
+	const bool bRenderTarget = bitmap->IsEmpty();
+	const bool bAlphaOnly = bitmap->format() == ultralight::BitmapFormat::A8_UNORM;
+	const uint32 Width = bitmap->width();
+	const uint32 Height = bitmap->height();
+	uint32 RowBytes = 0;
+	TArray<uint8> Pixels = CopyBitmapPixels(bitmap, RowBytes);
+
+	ENQUEUE_RENDER_COMMAND(ULUECreateTexture)(
+		[Resources = Resources, TextureId = texture_id, bRenderTarget, bAlphaOnly, Width, Height, RowBytes, Pixels = MoveTemp(Pixels)](FRHICommandListImmediate& RHICmdList)
+		{
+			ULUE_SCOPE_CYCLE_COUNTER(Upload);
+			ETextureCreateFlags Flags = ETextureCreateFlags::ShaderResource;
+			EPixelFormat Format = ULUERenderBufferFormat;
+			if (bRenderTarget)
+			{
+				Flags |= ETextureCreateFlags::RenderTargetable;
+			}
+			else if (bAlphaOnly)
+			{
+				Format = PF_A8;
+			}
+			else
+			{
+				Flags |= ETextureCreateFlags::SRGB;
+			}
+
+			const FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("UltralightTexture"), FMath::Max<uint32>(Width, 1), FMath::Max<uint32>(Height, 1), Format)
+				.SetFlags(Flags)
+				.SetClearValue(FClearValueBinding::Transparent)
+				.SetInitialState(ERHIAccess::SRVMask);
+			FTextureRHIRef Texture = RHICreateTexture(Desc);
+
+			if (Pixels.Num() > 0)
+			{
+				RHICmdList.UpdateTexture2D(Texture, 0, FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height), RowBytes, Pixels.GetData());
+			}
+
+			Resources->Textures.Add(TextureId, CreateRenderTarget(Texture, TEXT("UltralightTexture")));
+		});
+}
+
+void ULUEGPUDriver::UpdateTexture(uint32_t texture_id, ultralight::RefPtr<ultralight::Bitmap> bitmap)
+{
+	if (!bitmap || bitmap->IsEmpty())
+	{
+		return;
+	}
+
+	const uint32 Width = bitmap->width();
+	const uint32 Height = bitmap->height();
+	uint32 RowBytes = 0;
+	TArray<uint8> Pixels = CopyBitmapPixels(bitmap, RowBytes);
+
+	ENQUEUE_RENDER_COMMAND(ULUEUpdateTexture)(
+		[Resources = Resources, TextureId = texture_id, Width, Height, RowBytes, Pixels = MoveTemp(Pixels)](FRHICommandListImmediate& RHICmdList)
+		{
+			ULUE_SCOPE_CYCLE_COUNTER(Upload);
+			const TRefCountPtr<IPooledRenderTarget>* Texture = Resources->Textures.Find(TextureId);
+			if (Texture && Texture->IsValid() && Pixels.Num() > 0)
+			{
+				RHICmdList.UpdateTexture2D((*Texture)->GetRHI(), 0, FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height), RowBytes, Pixels.GetData());
+			}
+		});
+}
+
+void ULUEGPUDriver::DestroyTexture(uint32_t texture_id)
+{
+	ENQUEUE_RENDER_COMMAND(ULUEDestroyTexture)([Resources = Resources, TextureId = texture_id](FRHICommandListImmediate&)
+	{
+		Resources->Textures.Remove(TextureId);
+	});
+}
+
+void ULUEGPUDriver::CreateRenderBuffer(uint32_t render_buffer_id, const ultralight::RenderBuffer& buffer)
+{
+	ENQUEUE_RENDER_COMMAND(ULUECreateRenderBuffer)([Resources = Resources, RenderBufferId = render_buffer_id, TextureId = buffer.texture_id](FRHICommandListImmediate&)
+	{
+		Resources->RenderBufferTextures.Add(RenderBufferId, TextureId);
+	});
+}
+
+void ULUEGPUDriver::DestroyRenderBuffer(uint32_t render_buffer_id)
+{
+	RenderBufferNames.Remove(render_buffer_id);
+
+	ENQUEUE_RENDER_COMMAND(ULUEDestroyRenderBuffer)([Resources = Resources, RenderBufferId = render_buffer_id](FRHICommandListImmediate&)
+	{
+		Resources->RenderBufferTextures.Remove(RenderBufferId);
+		FScopeLock Lock(&Resources->GPUTimesLock);
+		Resources->GPUTimes.Remove(RenderBufferId);
+	});
+}
+
+void ULUEGPUDriver::CreateGeometry(uint32_t geometry_id, const ultralight::VertexBuffer& vertices, const ultralight::IndexBuffer& indices)
+{
+	EnqueueGeometryUpload(Resources, geometry_id, vertices, indices);
+}
+
+void ULUEGPUDriver::UpdateGeometry(uint32_t geometry_id, const ultralight::VertexBuffer& vertices, const ultralight::IndexBuffer& indices)
+{
+	EnqueueGeometryUpload(Resources, geometry_id, vertices, indices);
+}
+
+void ULUEGPUDriver::DestroyGeometry(uint32_t geometry_id)
+{
+	ENQUEUE_RENDER_COMMAND(ULUEDestroyGeometry)([Resources = Resources, GeometryId = geometry_id](FRHICommandListImmediate&)
+	{
+		Resources->Geometry.Remove(GeometryId);
+	});
+}
+
+void ULUEGPUDriver::UpdateCommandList(const ultralight::CommandList& list)
+{
+	if (list.size == 0 || !list.commands)
+	{
+		return;
+	}
+
+	PendingCommands.Append(list.commands, list.size);
+	for (uint32 Index = 0; Index < list.size; ++Index)
+	{
+		DrawnRenderBuffers.Add(list.commands[Index].gpu_state.render_buffer_id);
+	}
+}
+
+void ULUEGPUDriver::QueueResolve(const ultralight::RenderTarget& Source, FTextureRenderTargetResource* Destination)
+{
+	if (Source.is_empty || !Destination)
+	{
+		return;
+	}
+
+	FULUEResolveRequest& Request = PendingResolves.AddDefaulted_GetRef();
+	Request.TextureId = Source.texture_id;
+	Request.SourceRect = FIntRect(
+		FMath::RoundToInt(Source.uv_coords.left * Source.texture_width),
+		FMath::RoundToInt(Source.uv_coords.top * Source.texture_height),
+		FMath::RoundToInt(Source.uv_coords.left * Source.texture_width) + Source.width,
+		FMath::RoundToInt(Source.uv_coords.top * Source.texture_height) + Source.height);
+	Request.Destination = Destination;
+}
+
+float ULUEGPUDriver::GetRenderBufferGPUMilliseconds(uint32 RenderBufferId) const
+{
+	FScopeLock Lock(&Resources->GPUTimesLock);
+	const TPair<uint64, uint64>* Entry = Resources->GPUTimes.Find(RenderBufferId);
+	return Entry ? static_cast<float>(Entry->Value) / 1000.0f : 0.0f;
+}
+
+void ULUEGPUDriver::Trim()
+{
+	PendingCommands.Shrink();
+	PendingResolves.Shrink();
+	DrawnRenderBuffers.Compact();
+	RenderBufferNames.Compact();
+
+	ENQUEUE_RENDER_COMMAND(ULUETrimGPUResources)([Resources = Resources](FRHICommandListImmediate&)
+	{
+		Resources->Textures.Compact();
+		Resources->Geometry.Compact();
+		Resources->RenderBufferTextures.Compact();
+		Resources->PendingTimings.Shrink();
+		// Recreated lazily by the next timed pass.
+		if (Resources->PendingTimings.Num() == 0)
+		{
+			Resources->TimestampQueryPool.SafeRelease();
+		}
+		FScopeLock Lock(&Resources->GPUTimesLock);
+		Resources->GPUTimes.Compact();
+	});
+}
+
+void ULUEGPUDriver::Submit()
+{
+	DrawnRenderBuffers.Reset();
+	if (PendingCommands.Num() == 0 && PendingResolves.Num() == 0)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(ULUEExecuteCommandLists)(
+		[Resources = Resources, Commands = MoveTemp(PendingCommands), Resolves = MoveTemp(PendingResolves), Names = RenderBufferNames](FRHICommandListImmediate& RHICmdList)
+		{
+			FRDGBuilder GraphBuilder(RHICmdList, RDG_EVENT_NAME("Ultralight"));
+			ExecuteCommandLists(GraphBuilder, *Resources, Commands, Resolves, Names);
+			GraphBuilder.Execute();
+		});
+
+	PendingCommands.Reset();
+	PendingResolves.Reset();
+}
+
+} // namespace ultralightue
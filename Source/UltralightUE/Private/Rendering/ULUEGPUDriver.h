@@ -1,49 +1,125 @@
 /*
- * Minimal GPU driver implementation for Ultralight.
- * Since we're using CPU rendering (BitmapSurface), this driver is mostly empty.
- * However, Ultralight requires a GPUDriver to be set for proper initialization.
+ * GPU driver implementation for Ultralight.
+ * CPU views (BitmapSurface) never touch this driver; accelerated views record their textures,
+ * geometry and command lists here, which are replayed on the render thread through RDG.
  */
 
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "RHI.h"
+#include "RendererInterface.h"
 #include "ULUEUltralightIncludes.h"
 
+class FTextureRenderTargetResource;
+
 namespace ultralightue
 {
 
 /**
- * Empty GPU driver implementation for CPU rendering mode.
- * Ultralight requires a GPUDriver even when using BitmapSurfaceFactory.
+ * Render-thread mirror of every resource Ultralight created through the driver.
+ * Only mutated from render commands, so it needs no locking.
+ */
+struct FULUEGPUResources
+{
+	struct FGeometry
+	{
+		FBufferRHIRef VertexBuffer;
+		FBufferRHIRef IndexBuffer;
+		uint32 VertexBufferSize = 0;
+		uint32 IndexBufferSize = 0;
+		uint32 NumVertices = 0;
+	};
+
+	/// Begin/end timestamps around one raster pass, read back a few frames later.
+	struct FPendingTiming
+	{
+		uint64 Frame = 0;
+		uint32 RenderBufferId = 0;
+		FRHIPooledRenderQuery Begin;
+		FRHIPooledRenderQuery End;
+	};
+
+	TMap<uint32, TRefCountPtr<IPooledRenderTarget>> Textures;
+	/// Render buffer id -> backing texture id.
+	TMap<uint32, uint32> RenderBufferTextures;
+	TMap<uint32, FGeometry> Geometry;
+
+	FRenderQueryPoolRHIRef TimestampQueryPool;
+	TArray<FPendingTiming> PendingTimings;
+	uint64 SubmittedFrames = 0;
+
+	/// Render buffer id -> (frame, accumulated GPU microseconds). Read from the game thread.
+	TMap<uint32, TPair<uint64, uint64>> GPUTimes;
+	mutable FCriticalSection GPUTimesLock;
+};
+
+/** A copy of an accelerated view's render target into its UE render target. */
+struct FULUEResolveRequest
+{
+	uint32 TextureId = 0;
+	FIntRect SourceRect;
+	FTextureRenderTargetResource* Destination = nullptr;
+};
+
+/**
+ * GPU driver for accelerated views.
+ * Ultralight calls into this on the game thread during Renderer::Render(); resource changes are
+ * forwarded to the render thread immediately, command lists are queued until Submit().
  */
 class ULUEGPUDriver : public ultralight::GPUDriver
 {
 public:
-	ULUEGPUDriver() = default;
-	virtual ~ULUEGPUDriver() = default;
+	ULUEGPUDriver();
+	virtual ~ULUEGPUDriver() override;
 
-	// GPU Driver interface - all methods are empty since we use CPU rendering
 	virtual void BeginSynchronize() override {}
 	virtual void EndSynchronize() override {}
 
 	virtual uint32_t NextTextureId() override { return NextId++; }
-	virtual void CreateTexture(uint32_t texture_id, ultralight::RefPtr<ultralight::Bitmap> bitmap) override {}
-	virtual void UpdateTexture(uint32_t texture_id, ultralight::RefPtr<ultralight::Bitmap> bitmap) override {}
-	virtual void DestroyTexture(uint32_t texture_id) override {}
+	virtual void CreateTexture(uint32_t texture_id, ultralight::RefPtr<ultralight::Bitmap> bitmap) override;
+	virtual void UpdateTexture(uint32_t texture_id, ultralight::RefPtr<ultralight::Bitmap> bitmap) override;
+	virtual void DestroyTexture(uint32_t texture_id) override;
 
 	virtual uint32_t NextRenderBufferId() override { return NextId++; }
-	virtual void CreateRenderBuffer(uint32_t render_buffer_id, const ultralight::RenderBuffer& buffer) override {}
-	virtual void DestroyRenderBuffer(uint32_t render_buffer_id) override {}
+	virtual void CreateRenderBuffer(uint32_t render_buffer_id, const ultralight::RenderBuffer& buffer) override;
+	virtual void DestroyRenderBuffer(uint32_t render_buffer_id) override;
 
 	virtual uint32_t NextGeometryId() override { return NextId++; }
-	virtual void CreateGeometry(uint32_t geometry_id, const ultralight::VertexBuffer& vertices, const ultralight::IndexBuffer& indices) override {}
-	virtual void UpdateGeometry(uint32_t geometry_id, const ultralight::VertexBuffer& vertices, const ultralight::IndexBuffer& indices) override {}
-	virtual void DestroyGeometry(uint32_t geometry_id) override {}
+	virtual void CreateGeometry(uint32_t geometry_id, const ultralight::VertexBuffer& vertices, const ultralight::IndexBuffer& indices) override;
+	virtual void UpdateGeometry(uint32_t geometry_id, const ultralight::VertexBuffer& vertices, const ultralight::IndexBuffer& indices) override;
+	virtual void DestroyGeometry(uint32_t geometry_id) override;
+
+	virtual void UpdateCommandList(const ultralight::CommandList& list) override;
+
+	/// @brief Queues a copy of an accelerated view's render target into a UE render target.
+	void QueueResolve(const ultralight::RenderTarget& Source, FTextureRenderTargetResource* Destination);
+
+	/// @brief True if Ultralight drew into the render buffer since the last Submit().
+	bool WasRenderBufferDrawn(uint32 RenderBufferId) const { return DrawnRenderBuffers.Contains(RenderBufferId); }
+
+	/// @brief Names the GPU events and timings of a render buffer (view debug name or URL).
+	void SetRenderBufferName(uint32 RenderBufferId, const FString& Name) { RenderBufferNames.Add(RenderBufferId, Name); }
+
+	/// @brief GPU time of the render buffer's passes in the most recently read-back frame, in milliseconds.
+	float GetRenderBufferGPUMilliseconds(uint32 RenderBufferId) const;
+
+	/// @brief Releases slack in the driver's containers and, when idle, the timestamp query pool.
+	/// Live textures and geometry are owned by Ultralight and stay untouched.
+	void Trim();
 
-	virtual void UpdateCommandList(const ultralight::CommandList& list) override {}
+	/// @brief Sends queued command lists and resolves to the render thread as one RDG graph.
+	/// Each contiguous run of commands on a render buffer becomes its own raster pass.
+	void Submit();
 
 private:
-	uint32_t NextId = 1;
+	TSharedRef<FULUEGPUResources, ESPMode::ThreadSafe> Resources;
+	TArray<ultralight::Command> PendingCommands;
+	TArray<FULUEResolveRequest> PendingResolves;
+	TSet<uint32> DrawnRenderBuffers;
+	TMap<uint32, FString> RenderBufferNames;
+	uint32 NextId = 1;
 };
 
 } // namespace ultralightue
@@ -0,0 +1,125 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   Incremental hot reload of UI content for editor iteration.
+ */
+
+#include "Rendering/ULUEHotReload.h"
+
+#if WITH_EDITOR
+
+#include "Rendering/ULUERenderer.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+using namespace ultralightue;
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarHotReloadSettleSeconds(
+		TEXT("Ultralight.HotReloadSettleSeconds"),
+		0.1f,
+		TEXT("Quiet time after the last change in uicontent before hot reload applies it; editors often save in several writes."),
+		ECVF_Default);
+
+	IDirectoryWatcher* GetDirectoryWatcher()
+	{
+		FDirectoryWatcherModule* Module = FModuleManager::LoadModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		return Module ? Module->Get() : nullptr;
+	}
+}
+
+FULUEHotReload::FULUEHotReload(ULUEFileSystem& InFileSystem)
+	: FileSystem(InFileSystem)
+{
+	WatchedDirectory = FPaths::ConvertRelativePathToFull(FileSystem.GetBaseDirectory());
+	FPaths::NormalizeDirectoryName(WatchedDirectory);
+	WatchedDirectory.AppendChar(TEXT('/'));
+
+	if (IDirectoryWatcher* Watcher = GetDirectoryWatcher())
+	{
+		Watcher->RegisterDirectoryChangedCallback_Handle(
+			WatchedDirectory,
+			IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FULUEHotReload::OnDirectoryChanged),
+			WatchHandle);
+	}
+}
+
+FULUEHotReload::~FULUEHotReload()
+{
+	if (!WatchHandle.IsValid())
+	{
+		return;
+	}
+	if (IDirectoryWatcher* Watcher = GetDirectoryWatcher())
+	{
+		Watcher->UnregisterDirectoryChangedCallback_Handle(WatchedDirectory, WatchHandle);
+	}
+}
+
+void FULUEHotReload::OnDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (Change.Action == FFileChangeData::FCA_RescanRequired)
+		{
+			bRescanRequired = true;
+			continue;
+		}
+
+		FString Filename = FPaths::ConvertRelativePathToFull(Change.Filename);
+		FPaths::NormalizeFilename(Filename);
+		if (!Filename.StartsWith(WatchedDirectory))
+		{
+			continue;
+		}
+
+		// Drop the stale copy right away, even if no view is live to pick the change up.
+		const FString RelativePath = Filename.RightChop(WatchedDirectory.Len());
+		FileSystem.InvalidateFile(FileSystem.GetUEPath(RelativePath));
+		ChangedFiles.Add(RelativePath);
+	}
+
+	if (bRescanRequired)
+	{
+		FileSystem.InvalidateAllFiles();
+	}
+	LastChangeTime = FPlatformTime::Seconds();
+}
+
+void FULUEHotReload::Apply(TConstArrayView<TSharedPtr<FULUEView>> LiveViews)
+{
+	if ((ChangedFiles.Num() == 0 && !bRescanRequired)
+		|| FPlatformTime::Seconds() - LastChangeTime < CVarHotReloadSettleSeconds.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	int32 NumSwapped = 0;
+	int32 NumReloaded = 0;
+	for (const TSharedPtr<FULUEView>& View : LiveViews)
+	{
+		switch (View->ApplyContentChanges(ChangedFiles, bRescanRequired))
+		{
+		case EULUEHotReloadResult::SwappedStylesheets:
+			++NumSwapped;
+			break;
+		case EULUEHotReloadResult::Reloaded:
+			++NumReloaded;
+			break;
+		default:
+			break;
+		}
+	}
+
+	UE_LOG(LogUltralightUE, Log, TEXT("Hot reload: %s -> %d views restyled, %d reloaded, %d untouched"),
+		bRescanRequired ? TEXT("full rescan") : *FString::Join(ChangedFiles.Array(), TEXT(", ")),
+		NumSwapped, NumReloaded, LiveViews.Num() - NumSwapped - NumReloaded);
+
+	ChangedFiles.Reset();
+	bRescanRequired = false;
+}
+
+#endif // WITH_EDITOR
@@ -0,0 +1,49 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   Incremental hot reload of UI content for editor iteration.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+struct FFileChangeData;
+class FULUEView;
+
+namespace ultralightue
+{
+	class ULUEFileSystem;
+}
+
+/**
+ * Watches the uicontent directory and applies edits to live views without a full reload.
+ * Each changed file is invalidated in the file system's caches on its own; stylesheets are then swapped in
+ * place in every view, and anything else reloads only the views whose page depends on it.
+ * Game thread only.
+ */
+class FULUEHotReload
+{
+public:
+	FULUEHotReload(ultralightue::ULUEFileSystem& InFileSystem);
+	~FULUEHotReload();
+
+	/// @brief Applies the changes collected since the last call once they have settled. Called from FULUERenderer::Tick.
+	void Apply(TConstArrayView<TSharedPtr<FULUEView>> LiveViews);
+
+private:
+	void OnDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+	ultralightue::ULUEFileSystem& FileSystem;
+	/// Absolute, normalized uicontent directory with a trailing slash.
+	FString WatchedDirectory;
+	FDelegateHandle WatchHandle;
+
+	/// Changed files relative to uicontent ("menu/styles.css"), pending Apply.
+	TSet<FString> ChangedFiles;
+	bool bRescanRequired = false;
+	double LastChangeTime = 0.0;
+};
+
+#endif // WITH_EDITOR
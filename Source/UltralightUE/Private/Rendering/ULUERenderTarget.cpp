@@ -10,18 +10,23 @@
 #include "TextureResource.h"
 #include "RenderingThread.h"
 #include "RHICommandList.h"
+#include "Misc/ScopeExit.h"
 #include "ULUEUltralightIncludes.h"
+#include "ULUEStats.h"
 
 UULUERenderTarget::UULUERenderTarget()
     : RenderTarget(nullptr)
     , Width(0)
     , Height(0)
+    , LastUploadCycles(MakeShared<std::atomic<uint64>, ESPMode::ThreadSafe>(0))
 {
 }
 
 UULUERenderTarget::~UULUERenderTarget()
 {
     // Cleanup handled by UE garbage collection for UObject-based members
+    ultralightue::TrackMemory(ultralightue::EULUEMemoryCounter::RenderTarget, -TrackedRenderTargetBytes);
+    ultralightue::TrackMemory(ultralightue::EULUEMemoryCounter::Staging, -TrackedStagingBytes);
 }
 
 void UULUERenderTarget::Initialize(UTextureRenderTarget2D* InRenderTarget)
@@ -33,6 +38,26 @@ void UULUERenderTarget::Initialize(UTextureRenderTarget2D* InRenderTarget)
         Height = RenderTarget->SizeY;
         RenderTarget->UpdateResourceImmediate(true);
     }
+    RefreshMemoryStats();
+}
+
+void UULUERenderTarget::RefreshMemoryStats()
+{
+    const int64 RenderTargetBytes = RenderTarget
+        ? static_cast<int64>(RenderTarget->SizeX) * RenderTarget->SizeY * GPixelFormats[RenderTarget->GetFormat()].BlockBytes
+        : 0;
+    ultralightue::TrackMemory(ultralightue::EULUEMemoryCounter::RenderTarget, RenderTargetBytes - TrackedRenderTargetBytes);
+    TrackedRenderTargetBytes = RenderTargetBytes;
+
+    const int64 StagingBytes = static_cast<int64>(PixelData.GetAllocatedSize());
+    ultralightue::TrackMemory(ultralightue::EULUEMemoryCounter::Staging, StagingBytes - TrackedStagingBytes);
+    TrackedStagingBytes = StagingBytes;
+}
+
+void UULUERenderTarget::ReleaseStagingMemory()
+{
+    PixelData.Empty();
+    RefreshMemoryStats();
 }
 
 void UULUERenderTarget::OnUltralightDraw(ultralight::Bitmap* Bitmap)
@@ -50,6 +75,7 @@ void UULUERenderTarget::OnUltralightDraw(ultralight::Bitmap* Bitmap)
         Height = Bitmap->height();
         RenderTarget->ResizeTarget(Width, Height);
         RenderTarget->UpdateResourceImmediate(false);
+        RefreshMemoryStats();
     }
 
     // Copy pixel data out before unlocking (Ultralight requires this)
@@ -60,6 +86,14 @@ void UULUERenderTarget::OnUltralightDraw(ultralight::Bitmap* Bitmap)
         return;
     }
     PixelData.SetNumUninitialized(TotalSize);
+    RefreshMemoryStats();
+
+    FTextureRenderTargetResource* TargetResource = RenderTarget->GameThread_GetRenderTargetResource();
+    if (!TargetResource)
+    {
+        PixelData.Reset();
+        return;
+    }
 
     const void* LockedPixels = Bitmap->LockPixels();
     if (!LockedPixels)
@@ -68,63 +102,79 @@ void UULUERenderTarget::OnUltralightDraw(ultralight::Bitmap* Bitmap)
         return;
     }
 
-    // Ultralight outputs BGRA format (4 bytes per pixel)
-    // The image appears to be both horizontally and vertically flipped
-    // Perform 180-degree rotation: flip both rows and pixels within each row
-    const uint8* SrcPixels = static_cast<const uint8*>(LockedPixels);
-    uint8* DstPixels = PixelData.GetData();
-
-    const uint32 PixelSize = 4; // BGRA = 4 bytes per pixel
-    const uint32 PixelsPerRow = SourceRowBytes / PixelSize;
-
-    // Start from last row, last pixel
-    for (uint32 Row = 0; Row < Height; ++Row)
+    // The Copy stat covers the flip and the render-thread duplicate; the upload is enqueued outside it.
+    TArray<uint8> PixelCopy;
     {
-        const uint8* SrcRow = SrcPixels + (Height - 1 - Row) * SourceRowBytes; // Last row first
-        uint8* DstRow = DstPixels + Row * SourceRowBytes;
-
-        // Copy pixels in reverse order within each row
-        for (uint32 Col = 0; Col < PixelsPerRow; ++Col)
+        // Ultralight outputs BGRA format (4 bytes per pixel)
+        // The image appears to be both horizontally and vertically flipped
+        // Perform 180-degree rotation: flip both rows and pixels within each row
+        ULUE_SCOPE_CYCLE_COUNTER(Copy);
+        const uint8* SrcPixels = static_cast<const uint8*>(LockedPixels);
+        uint8* DstPixels = PixelData.GetData();
+
+        const uint32 PixelSize = 4; // BGRA = 4 bytes per pixel
+        const uint32 PixelsPerRow = SourceRowBytes / PixelSize;
+
+        // Start from last row, last pixel
+        for (uint32 Row = 0; Row < Height; ++Row)
         {
-            const uint8* SrcPixel = SrcRow + (PixelsPerRow - 1 - Col) * PixelSize; // Last pixel first
-            uint8* DstPixel = DstRow + Col * PixelSize;
-
-            // Copy 4 bytes (BGRA)
-            DstPixel[0] = SrcPixel[0]; // B
-            DstPixel[1] = SrcPixel[1]; // G
-            DstPixel[2] = SrcPixel[2]; // R
-            DstPixel[3] = SrcPixel[3]; // A
-        }
-    }
+            const uint8* SrcRow = SrcPixels + (Height - 1 - Row) * SourceRowBytes; // Last row first
+            uint8* DstRow = DstPixels + Row * SourceRowBytes;
 
-    Bitmap->UnlockPixels();
+            // Copy pixels in reverse order within each row
+            for (uint32 Col = 0; Col < PixelsPerRow; ++Col)
+            {
+                const uint8* SrcPixel = SrcRow + (PixelsPerRow - 1 - Col) * PixelSize; // Last pixel first
+                uint8* DstPixel = DstRow + Col * PixelSize;
+
+                // Copy 4 bytes (BGRA)
+                DstPixel[0] = SrcPixel[0]; // B
+                DstPixel[1] = SrcPixel[1]; // G
+                DstPixel[2] = SrcPixel[2]; // R
+                DstPixel[3] = SrcPixel[3]; // A
+            }
+        }
 
-    // Upload to render target on the render thread
-    FTextureRenderTargetResource* TargetResource = RenderTarget->GameThread_GetRenderTargetResource();
-    if (!TargetResource)
-    {
-        PixelData.Reset();
-        return;
+        Bitmap->UnlockPixels();
+        PixelCopy = PixelData; // copy for thread safety
     }
 
+    // Upload to render target on the render thread
     const uint32 CopyWidth = Bitmap->width();
     const uint32 CopyHeight = Bitmap->height();
-    TArray<uint8> PixelCopy = PixelData; // copy for thread safety
+    LastUploadBytes = PixelCopy.Num();
+    INC_DWORD_STAT_BY(STAT_UltralightViewUploadBytes, PixelCopy.Num());
+    // The in-flight copy is staging memory until the render thread has uploaded it.
+    const int64 InFlightBytes = PixelCopy.GetAllocatedSize();
+    ultralightue::TrackMemory(ultralightue::EULUEMemoryCounter::Staging, InFlightBytes);
 
     ENQUEUE_RENDER_COMMAND(CopyUltralightToRT)(
-        [TargetResource, PixelCopy = MoveTemp(PixelCopy), SourceRowBytes, CopyWidth, CopyHeight](FRHICommandListImmediate& RHICmdList) mutable
+        [TargetResource, PixelCopy = MoveTemp(PixelCopy), SourceRowBytes, CopyWidth, CopyHeight, UploadCycles = LastUploadCycles, InFlightBytes](FRHICommandListImmediate& RHICmdList) mutable
         {
+            ON_SCOPE_EXIT
+            {
+                ultralightue::TrackMemory(ultralightue::EULUEMemoryCounter::Staging, -InFlightBytes);
+            };
+
             FRHITexture* TextureRHI = TargetResource->GetRenderTargetTexture();
             if (!TextureRHI || PixelCopy.Num() == 0)
             {
                 return;
             }
 
+            ULUE_SCOPE_CYCLE_COUNTER(Upload);
+            const uint64 StartCycles = FPlatformTime::Cycles64();
             const FUpdateTextureRegion2D UpdateRegion(0, 0, 0, 0, CopyWidth, CopyHeight);
             RHICmdList.UpdateTexture2D(TextureRHI, 0, UpdateRegion, SourceRowBytes, PixelCopy.GetData());
+            UploadCycles->store(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
         });
 }
 
+float UULUERenderTarget::GetLastUploadMilliseconds() const
+{
+    return static_cast<float>(FPlatformTime::ToMilliseconds64(LastUploadCycles->load(std::memory_order_relaxed)));
+}
+
 void UULUERenderTarget::UpdateUETexture()
 {
     if (!RenderTarget || PixelData.Num() == 0)
@@ -6,10 +6,18 @@
 #include "Rendering/ULUERenderer.h"
 #include "Rendering/ULUERenderTarget.h"
 #include "Rendering/ULUEGPUDriver.h"
+#include "Rendering/ULUEHotReload.h"
+#include "Fonts/ULUEFontLoader.h"
+#include "Memory/ULUEAllocator.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "TextureResource.h"
+#include "Misc/App.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
 #include "AppCore/Platform.h"
 #include "Ultralight/platform/Surface.h"
 
@@ -22,47 +30,176 @@ namespace
 	{
 		return ultralight::String(TCHAR_TO_UTF8(*InString));
 	}
+
+	uint32 GNextViewId = 1;
+
+	const TCHAR* PurgeReasonToString(EULUEPurgeReason Reason)
+	{
+		switch (Reason)
+		{
+		case EULUEPurgeReason::Manual:
+			return TEXT("manual");
+		case EULUEPurgeReason::LevelTransition:
+			return TEXT("level transition");
+		case EULUEPurgeReason::MemoryTrim:
+			return TEXT("memory trim");
+		case EULUEPurgeReason::OutOfMemory:
+			return TEXT("out of memory");
+		default:
+			return TEXT("none");
+		}
+	}
+
+	/// New (and thawed) views repaint unconditionally for this many frames while content settles.
+	constexpr int32 ForcedRenderFrames = 30;
+
+	TAutoConsoleVariable<int32> CVarMaxActiveViews(
+		TEXT("Ultralight.MaxActiveViews"),
+		0,
+		TEXT("Maximum number of unfrozen views. Least-recently-used views with auto-freeze enabled are frozen beyond this. 0 = unlimited."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarMemoryBudgetMB(
+		TEXT("Ultralight.MemoryBudgetMB"),
+		0,
+		TEXT("Ultralight memory budget in MB. Measured as the library heap when the allocator override is active, otherwise as the surfaces of unfrozen views. ")
+		TEXT("Least-recently-used auto-freeze views are frozen while over budget. 0 = off."),
+		ECVF_Default);
+
+#if WITH_EDITOR
+	TAutoConsoleVariable<bool> CVarHotReload(
+		TEXT("Ultralight.HotReload"),
+		true,
+		TEXT("Editor only: watch uicontent and apply edits to live views (stylesheets swapped in place, other files reload only dependent views). ")
+		TEXT("Read when the renderer starts."),
+		ECVF_Default);
+#endif
+
+	TAutoConsoleVariable<bool> CVarFreezeViewsOnMemoryPressure(
+		TEXT("Ultralight.FreezeViewsOnMemoryPressure"),
+		true,
+		TEXT("Freeze every auto-freeze view when a memory warning or out-of-memory purge runs."),
+		ECVF_Default);
+
+	/// Initialized renderers, for the console commands below. Game thread only.
+	TArray<FULUERenderer*> GLiveRenderers;
+
+	/// The renderer handed out by FULUERenderer::Acquire and its reference count. Game thread only.
+	TSharedPtr<FULUERenderer> GSharedRenderer;
+	int32 GSharedRendererRefCount = 0;
+	/// Arguments the shared renderer was initialized with; later Acquire calls must match them.
+	FString GSharedRendererBaseDir;
+	FSAccess GSharedRendererAccessPattern = FSAccess::FSA_Native;
+
+	FAutoConsoleCommand GLogMemoryUsageCommand(
+		TEXT("Ultralight.LogMemoryUsage"),
+		TEXT("Dumps Ultralight's memory usage (Renderer::LogMemoryUsage) and the plugin's memory counters to the log."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			for (FULUERenderer* Renderer : GLiveRenderers)
+			{
+				Renderer->LogMemoryUsage();
+			}
+		}));
+
+	FAutoConsoleCommand GPurgeMemoryCommand(
+		TEXT("Ultralight.PurgeMemory"),
+		TEXT("Frees Ultralight's caches and the plugin's transient buffers, as on a memory warning."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			for (FULUERenderer* Renderer : GLiveRenderers)
+			{
+				Renderer->PurgeMemory(EULUEPurgeReason::Manual);
+			}
+		}));
 }
 
 /* -------------------------------------------------------------------------- */
 /*                              FULUEView                                     */
 /* -------------------------------------------------------------------------- */
 
-FULUEView::FULUEView(const TWeakPtr<FULUERenderer>& InOwner, ultralight::RefPtr<ultralight::View> InView, UULUERenderTarget* InTarget)
+FULUEView::FULUEView(const TWeakPtr<FULUERenderer>& InOwner, ultralight::RefPtr<ultralight::View> InView, UULUERenderTarget* InTarget, const ultralight::ViewConfig& InConfig, const ultralight::RefPtr<ultralight::Session>& InSession)
 	: Owner(InOwner)
 	, View(MoveTemp(InView))
 	, Target(InTarget)
 	, Size(FIntPoint::ZeroValue)
+	, ViewId(GNextViewId++)
+	, Config(InConfig)
+	, Session(InSession)
+	, LastUsedTime(FPlatformTime::Seconds())
+	, ScriptBridge(MakeUnique<FULUEJSBridge>())
 {
 	if (View)
 	{
 		Size = FIntPoint(View->width(), View->height());
+		ScriptBridge->Attach(View.get());
 	}
+	RefreshStatName();
+	INC_DWORD_STAT(STAT_UltralightLiveViews);
 }
 
-FULUEView::~FULUEView() = default;
+FULUEView::~FULUEView()
+{
+	EndReadahead(false);
+	ScriptBridge->Detach();
+	DEC_DWORD_STAT(STAT_UltralightLiveViews);
+	if (bFrozen)
+	{
+		DEC_DWORD_STAT(STAT_UltralightFrozenViews);
+	}
+}
 
 void FULUEView::LoadURL(const FString& URL)
 {
+	LastURL = URL;
+	LastHTML.Empty();
+	bLastLoadWasHTML = false;
+	FrozenScroll = FVector2D::ZeroVector;
+	Touch();
+
+	// A frozen view picks the new source up in Thaw().
+	if (bFrozen)
+	{
+		Thaw();
+		return;
+	}
+
 	if (View)
 	{
 		UE_LOG(LogUltralightUE, Log, TEXT("Loading URL: %s"), *URL);
+		BeginReadahead(URL);
 		View->LoadURL(ToUltralightString(URL));
+		RefreshStatName();
 	}
 }
 
 void FULUEView::LoadHTML(const FString& HTML, const FString& VirtualURL)
 {
+	LastURL = VirtualURL;
+	LastHTML = HTML;
+	bLastLoadWasHTML = true;
+	FrozenScroll = FVector2D::ZeroVector;
+	Touch();
+
+	if (bFrozen)
+	{
+		Thaw();
+		return;
+	}
+
 	if (View)
 	{
+		EndReadahead(false);
 		UE_LOG(LogUltralightUE, Log, TEXT("Loading HTML (VirtualURL: %s, Length: %d)"), *VirtualURL, HTML.Len());
 		View->LoadHTML(ToUltralightString(HTML), ToUltralightString(VirtualURL), true);
+		RefreshStatName();
 	}
 }
 
 void FULUEView::Resize(const FIntPoint& InSize)
 {
-	if (!View || InSize == Size)
+	// Resizing clears the render target, so a frozen view has nothing left to show; bring it back.
+	if (InSize == Size || !EnsureThawed() || !View)
 	{
 		return;
 	}
@@ -75,12 +212,20 @@ void FULUEView::Resize(const FIntPoint& InSize)
 		if (UTextureRenderTarget2D* Texture = RenderTarget->GetRenderTarget())
 		{
 			Texture->ResizeTarget(Size.X, Size.Y);
+			RenderTarget->RefreshMemoryStats();
 		}
 	}
 }
 
-void FULUEView::SetFocused(bool bFocused)
+void FULUEView::SetFocused(bool bInFocused)
 {
+	bFocused = bInFocused;
+	if (bFocused)
+	{
+		Touch();
+		EnsureThawed();
+	}
+
 	if (!View)
 	{
 		return;
@@ -98,16 +243,401 @@ void FULUEView::SetFocused(bool bFocused)
 
 void FULUEView::PaintIfNeeded()
 {
+	ULUE_SCOPE_CYCLE_COUNTER(Paint);
+	FULUETraceViewContext TraceContext(ViewId, LastURL);
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight Paint [%u] %s"), ViewId, *Timings.Name));
+
 	if (!View || !Target.IsValid())
 	{
 		return;
 	}
 
-	CopySurfaceToTarget();
+	// Keep showing the frozen frame until the rebuilt page has loaded.
+	if (bThawing)
+	{
+		if (View->is_loading())
+		{
+			return;
+		}
+		bThawing = false;
+	}
+
+	Timings.CopyMs = 0.0f;
+	Timings.UploadBytes = 0;
+	{
+		FULUEViewStageScope Scope(StageStatIds[static_cast<int32>(EULUEViewStage::Copy)], StageEventNames[static_cast<int32>(EULUEViewStage::Copy)], Timings.CopyMs);
+		CopySurfaceToTarget();
+	}
+
+	if (View->is_accelerated())
+	{
+		// GPU path has no CPU copy; report the view's pass time from RHI timestamps instead.
+		TSharedPtr<FULUERenderer> Renderer = Owner.Pin();
+		ULUEGPUDriver* Driver = Renderer.IsValid() ? Renderer->GetGPUDriver() : nullptr;
+		Timings.GPUMs = Driver ? Driver->GetRenderBufferGPUMilliseconds(View->render_target().render_buffer_id) : 0.0f;
+	}
+	else if (UULUERenderTarget* RenderTarget = Target.Get())
+	{
+		Timings.UploadMs = RenderTarget->GetLastUploadMilliseconds();
+	}
+}
+
+void FULUEView::ReleaseTransientMemory()
+{
+	if (UULUERenderTarget* RenderTarget = Target.Get())
+	{
+		RenderTarget->ReleaseStagingMemory();
+	}
+}
+
+void FULUEView::Render(ultralight::Renderer& Renderer, float UpdateShareMs)
+{
+	Timings.UpdateShareMs = UpdateShareMs;
+	if (!View)
+	{
+		return;
+	}
+
+	if (!ReadaheadURL.IsEmpty() && !View->is_loading())
+	{
+		EndReadahead(true);
+	}
+
+	if (bPendingScrollRestore && !View->is_loading())
+	{
+		bPendingScrollRestore = false;
+		View->EvaluateScript(ToUltralightString(FString::Printf(TEXT("window.scrollTo(%f, %f)"), FrozenScroll.X, FrozenScroll.Y)));
+	}
+
+	FULUETraceViewContext TraceContext(ViewId, LastURL);
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight Render [%u] %s"), ViewId, *Timings.Name));
+	FULUEViewStageScope Scope(StageStatIds[static_cast<int32>(EULUEViewStage::Render)], StageEventNames[static_cast<int32>(EULUEViewStage::Render)], Timings.RenderMs);
+	ultralight::View* Views[] = { View.get() };
+	Renderer.RenderOnly(Views, 1);
+}
+
+bool FULUEView::Freeze()
+{
+	if (bFrozen || !View)
+	{
+		return false;
+	}
+
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight Freeze [%u] %s"), ViewId, *Timings.Name));
+
+	// Scroll position is the only page state we carry over; everything else is rebuilt by reloading.
+	CaptureScroll();
+
+	// The render target keeps the last frame; dropping the RefPtr releases the DOM, JS heap and surface.
+	EndReadahead(false);
+	ScriptBridge->Detach();
+	View = ultralight::RefPtr<ultralight::View>();
+	bFrozen = true;
+	bThawing = false;
+	bPendingScrollRestore = false;
+	ReleaseTransientMemory();
+	INC_DWORD_STAT(STAT_UltralightFrozenViews);
+
+	UE_LOG(LogUltralightUE, Verbose, TEXT("Froze view %u (%s)"), ViewId, *Timings.Name);
+	return true;
+}
+
+bool FULUEView::Thaw()
+{
+	if (!bFrozen)
+	{
+		return View.get() != nullptr;
+	}
+
+	TSharedPtr<FULUERenderer> Renderer = Owner.Pin();
+	if (!Renderer.IsValid())
+	{
+		return false;
+	}
+
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight Thaw [%u] %s"), ViewId, *Timings.Name));
+
+	View = Renderer->CreateNativeView(Size, Config, Session);
+	if (!View)
+	{
+		UE_LOG(LogUltralightUE, Warning, TEXT("Failed to thaw view %u (%s)"), ViewId, *Timings.Name);
+		return false;
+	}
+	// Published buffers reappear once the reloaded page's window object is ready.
+	ScriptBridge->Attach(View.get());
+
+	bFrozen = false;
+	bThawing = true;
+	FramesSinceCreation = 0;
+	DEC_DWORD_STAT(STAT_UltralightFrozenViews);
+
+	if (bLastLoadWasHTML)
+	{
+		View->LoadHTML(ToUltralightString(LastHTML), ToUltralightString(LastURL), true);
+	}
+	else if (!LastURL.IsEmpty())
+	{
+		BeginReadahead(LastURL);
+		View->LoadURL(ToUltralightString(LastURL));
+	}
+	bPendingScrollRestore = !FrozenScroll.IsZero();
+
+	if (bFocused)
+	{
+		View->Focus();
+	}
+
+	// New native view means a new render buffer to name in the GPU driver.
+	RefreshStatName();
+	Touch();
+
+	UE_LOG(LogUltralightUE, Verbose, TEXT("Thawed view %u (%s)"), ViewId, *Timings.Name);
+	return true;
+}
+
+EULUEHotReloadResult FULUEView::ApplyContentChanges(const TSet<FString>& ChangedFiles, bool bReloadAll)
+{
+	// Frozen views read the already invalidated files when they thaw.
+	if (!View || bFrozen || !LastURL.StartsWith(TEXT("file:///"), ESearchCase::IgnoreCase))
+	{
+		return EULUEHotReloadResult::None;
+	}
+
+	TSharedPtr<FULUERenderer> Renderer = Owner.Pin();
+	ULUEFileSystem* FileSystem = Renderer.IsValid() ? Renderer->GetFileSystem() : nullptr;
+	const FString Page = FULUEReadaheadManifest::NormalizePath(LastURL);
+	const TArray<FString> Dependencies = FileSystem ? FileSystem->GetPageDependencies(LastURL) : TArray<FString>();
+
+	// LoadHTML content isn't on disk; only what it references can change. Pages that were never recorded
+	// (readahead off, or still on their first load) may depend on anything.
+	bool bReload = bReloadAll && !bLastLoadWasHTML;
+	TArray<FString> Stylesheets;
+	for (const FString& File : ChangedFiles)
+	{
+		if (File.EndsWith(TEXT(".css"), ESearchCase::IgnoreCase))
+		{
+			Stylesheets.Add(File);
+		}
+		else if (bLastLoadWasHTML ? Dependencies.Contains(File) : (File == Page || Dependencies.Num() == 0 || Dependencies.Contains(File)))
+		{
+			bReload = true;
+		}
+	}
+
+	if (!bReload && Stylesheets.Num() > 0)
+	{
+		// Re-point matching <link> elements at a cache-busting URL; the file system ignores the query.
+		FString FileList;
+		for (const FString& File : Stylesheets)
+		{
+			FileList += FString::Printf(TEXT("%s\"%s\""), FileList.IsEmpty() ? TEXT("") : TEXT(","), *File.ReplaceCharWithEscapedChar());
+		}
+		const FString Script = FString::Printf(TEXT(
+			"(function(files) {"
+			"  var swapped = [];"
+			"  document.querySelectorAll('link[rel~=\"stylesheet\"]').forEach(function(link) {"
+			"    var url = new URL(link.href);"
+			"    var path = decodeURIComponent(url.pathname).replace(/^\\/+/, '');"
+			"    if (files.indexOf(path) < 0) return;"
+			"    url.searchParams.set('ulue-hot-reload', Date.now());"
+			"    link.href = url.href;"
+			"    swapped.push(path);"
+			"  });"
+			"  return swapped.join('\\n');"
+			"})([%s])"), *FileList);
+		const ultralight::String Result = View->EvaluateScript(ToUltralightString(Script));
+
+		TArray<FString> Swapped;
+		FString(UTF8_TO_TCHAR(Result.utf8().data())).ParseIntoArrayLines(Swapped);
+
+		// A stylesheet the page uses without a <link> (@import, CSS-in-JS) can only be picked up by reloading.
+		for (const FString& File : Stylesheets)
+		{
+			if (!Swapped.Contains(File) && Dependencies.Contains(File))
+			{
+				bReload = !bLastLoadWasHTML;
+			}
+		}
+		if (!bReload)
+		{
+			return Swapped.Num() > 0 ? EULUEHotReloadResult::SwappedStylesheets : EULUEHotReloadResult::None;
+		}
+	}
+
+	if (!bReload)
+	{
+		return EULUEHotReloadResult::None;
+	}
+
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight HotReload [%u] %s"), ViewId, *Timings.Name));
+	CaptureScroll();
+	// Same as Thaw(): LoadHTML content is re-submitted, since LastURL is only its virtual base URL.
+	if (bLastLoadWasHTML)
+	{
+		View->LoadHTML(ToUltralightString(LastHTML), ToUltralightString(LastURL), true);
+	}
+	else
+	{
+		BeginReadahead(LastURL);
+		View->LoadURL(ToUltralightString(LastURL));
+	}
+	bPendingScrollRestore = !FrozenScroll.IsZero();
+	return EULUEHotReloadResult::Reloaded;
+}
+
+void FULUEView::CaptureScroll()
+{
+	const ultralight::String ScrollResult = View->EvaluateScript("window.scrollX + ',' + window.scrollY");
+	FString ScrollX, ScrollY;
+	if (FString(UTF8_TO_TCHAR(ScrollResult.utf8().data())).Split(TEXT(","), &ScrollX, &ScrollY))
+	{
+		FrozenScroll = FVector2D(FCString::Atod(*ScrollX), FCString::Atod(*ScrollY));
+	}
+}
+
+bool FULUEView::EnsureThawed()
+{
+	return !bFrozen || Thaw();
+}
+
+bool FULUEView::CanAutoFreeze() const
+{
+	return bAutoFreeze && !bFrozen && !bFocused && View && !View->is_loading() && FramesSinceCreation >= ForcedRenderFrames;
+}
+
+int64 FULUEView::GetEstimatedNativeBytes() const
+{
+	return View ? static_cast<int64>(Size.X) * Size.Y * 4 : 0;
+}
+
+void FULUEView::BeginReadahead(const FString& URL)
+{
+	EndReadahead(false);
+
+	TSharedPtr<FULUERenderer> Renderer = Owner.Pin();
+	ULUEFileSystem* FileSystem = Renderer.IsValid() ? Renderer->GetFileSystem() : nullptr;
+	if (FileSystem && FileSystem->BeginPageLoad(URL))
+	{
+		ReadaheadURL = URL;
+	}
+}
+
+void FULUEView::EndReadahead(bool bCommit)
+{
+	if (ReadaheadURL.IsEmpty())
+	{
+		return;
+	}
+
+	TSharedPtr<FULUERenderer> Renderer = Owner.Pin();
+	if (ULUEFileSystem* FileSystem = Renderer.IsValid() ? Renderer->GetFileSystem() : nullptr)
+	{
+		FileSystem->EndPageLoad(ReadaheadURL, bCommit);
+	}
+	ReadaheadURL.Reset();
+}
+
+void FULUEView::PublishBuffer(const FString& Name, const FULUEJSBufferRef& Buffer)
+{
+	ScriptBridge->PublishBuffer(Name, Buffer);
+}
+
+void FULUEView::UnpublishBuffer(const FString& Name)
+{
+	ScriptBridge->UnpublishBuffer(Name);
+}
+
+void FULUEView::BindFunction(const FString& Name, FULUEJSCallback&& Callback)
+{
+	ScriptBridge->BindFunction(Name, MoveTemp(Callback));
+}
+
+void FULUEView::UnbindFunction(const FString& Name)
+{
+	ScriptBridge->UnbindFunction(Name);
+}
+
+void FULUEView::EnqueueCall(const FString& Function, TArray<FULUEJSValue>&& Args)
+{
+	// A page that is being updated isn't static; keep it out of the freeze candidates.
+	Touch();
+	if (EnsureThawed())
+	{
+		ScriptBridge->EnqueueCall(Function, MoveTemp(Args));
+	}
+}
+
+void FULUEView::FlushScriptBridge()
+{
+	ScriptBridge->Flush();
+}
+
+void FULUEView::Detach()
+{
+	EndReadahead(false);
+	if (bFrozen)
+	{
+		bFrozen = false;
+		DEC_DWORD_STAT(STAT_UltralightFrozenViews);
+	}
+	bThawing = false;
+	bPendingScrollRestore = false;
+	ScriptBridge->Detach();
+	View = nullptr;
+	Session = nullptr;
+	Owner.Reset();
+}
+
+void FULUEView::Touch()
+{
+	LastUsedTime = FPlatformTime::Seconds();
+}
+
+void FULUEView::SetDebugName(const FString& InDebugName)
+{
+	DebugName = InDebugName;
+	RefreshStatName();
+}
+
+void FULUEView::RefreshStatName()
+{
+	TraceViewInfo(ViewId, LastURL, DebugName);
+
+	const FString Name = !DebugName.IsEmpty() ? DebugName : (!LastURL.IsEmpty() ? LastURL : TEXT("<blank>"));
+	if (Name != Timings.Name)
+	{
+		Timings.Name = Name;
+		StageEventNames[static_cast<int32>(EULUEViewStage::Render)] = FString::Printf(TEXT("Ultralight Render: %s"), *Name);
+		StageEventNames[static_cast<int32>(EULUEViewStage::Copy)] = FString::Printf(TEXT("Ultralight Copy: %s"), *Name);
+#if STATS
+		for (int32 Stage = 0; Stage < static_cast<int32>(EULUEViewStage::Num); ++Stage)
+		{
+			StageStatIds[Stage] = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_Ultralight>(StageEventNames[Stage]);
+		}
+#endif
+	}
+
+	if (View && View->is_accelerated())
+	{
+		if (TSharedPtr<FULUERenderer> Renderer = Owner.Pin())
+		{
+			if (ULUEGPUDriver* Driver = Renderer->GetGPUDriver())
+			{
+				Driver->SetRenderBufferName(View->render_target().render_buffer_id, Name);
+			}
+		}
+	}
 }
 
 void FULUEView::InjectMouseEvent(ultralight::MouseEvent::Type Type, const FVector2D& Position, ultralight::MouseEvent::Button Button, uint32 /*Modifiers*/)
 {
+	Touch();
+	// Hovering over a frozen view doesn't wake it; clicks do.
+	if (Type != ultralight::MouseEvent::kType_MouseMoved)
+	{
+		EnsureThawed();
+	}
+
 	if (!View)
 	{
 		return;
@@ -123,6 +653,9 @@ void FULUEView::InjectMouseEvent(ultralight::MouseEvent::Type Type, const FVecto
 
 void FULUEView::InjectScroll(const FVector2D& ScrollDelta, bool bByPage, uint32 /*Modifiers*/)
 {
+	Touch();
+	EnsureThawed();
+
 	if (!View)
 	{
 		return;
@@ -137,6 +670,9 @@ void FULUEView::InjectScroll(const FVector2D& ScrollDelta, bool bByPage, uint32
 
 void FULUEView::InjectKeyEvent(const ultralight::KeyEvent& Event)
 {
+	Touch();
+	EnsureThawed();
+
 	if (View)
 	{
 		View->FireKeyEvent(Event);
@@ -160,6 +696,16 @@ void FULUEView::CopySurfaceToTarget()
 		return;
 	}
 
+	// Always try to render on first few frames or when dirty
+	bool bForceRender = (FramesSinceCreation < ForcedRenderFrames);
+	FramesSinceCreation++;
+
+	if (View->is_accelerated())
+	{
+		ResolveRenderTarget(bForceRender);
+		return;
+	}
+
 	ultralight::Surface* Surface = View->surface();
 	if (!Surface)
 	{
@@ -169,10 +715,6 @@ void FULUEView::CopySurfaceToTarget()
 	// Check if there's anything to paint
 	bool bHasDirtyBounds = !Surface->dirty_bounds().IsEmpty();
 
-	// Always try to render on first few frames or when dirty
-	bool bForceRender = (FramesSinceCreation < 30); // Force render for first 30 frames
-	FramesSinceCreation++;
-
 	if (!bHasDirtyBounds && !bForceRender)
 	{
 		return;
@@ -189,15 +731,88 @@ void FULUEView::CopySurfaceToTarget()
 	if (Bitmap && Bitmap.get() && Target.IsValid())
 	{
 		Target->OnUltralightDraw(Bitmap.get());
+		Timings.UploadBytes = static_cast<int64>(Target->GetLastUploadBytes());
 	}
 
 	Surface->ClearDirtyBounds();
 }
 
+void FULUEView::ResolveRenderTarget(bool bForceRender)
+{
+	TSharedPtr<FULUERenderer> Renderer = Owner.Pin();
+	ULUEGPUDriver* Driver = Renderer.IsValid() ? Renderer->GetGPUDriver() : nullptr;
+	UTextureRenderTarget2D* Texture = GetRenderTarget();
+	if (!Driver || !Texture)
+	{
+		return;
+	}
+
+	// Only copy when Ultralight actually drew into this view's render buffer this frame.
+	const ultralight::RenderTarget Source = View->render_target();
+	if (!bForceRender && !Driver->WasRenderBufferDrawn(Source.render_buffer_id))
+	{
+		return;
+	}
+
+	Driver->QueueResolve(Source, Texture->GameThread_GetRenderTargetResource());
+}
+
 /* -------------------------------------------------------------------------- */
 /*                            FULUERenderer                                   */
 /* -------------------------------------------------------------------------- */
 
+TSharedPtr<FULUERenderer> FULUERenderer::Acquire(const FString& PluginBaseDir, FSAccess AccessPattern)
+{
+	check(IsInGameThread());
+
+	if (!GSharedRenderer.IsValid())
+	{
+		TSharedPtr<FULUERenderer> NewRenderer = MakeShared<FULUERenderer>();
+		if (!NewRenderer->Initialize(PluginBaseDir, AccessPattern, nullptr))
+		{
+			NewRenderer->Shutdown();
+			return nullptr;
+		}
+
+		NewRenderer->TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSPLambda(NewRenderer.ToSharedRef(), [SharedRenderer = NewRenderer.Get()](float DeltaSeconds)
+		{
+			SharedRenderer->Tick(DeltaSeconds);
+			return true;
+		}));
+		GSharedRenderer = NewRenderer;
+		GSharedRendererBaseDir = PluginBaseDir;
+		GSharedRendererAccessPattern = AccessPattern;
+	}
+	else
+	{
+		ensureMsgf(PluginBaseDir == GSharedRendererBaseDir && AccessPattern == GSharedRendererAccessPattern,
+			TEXT("FULUERenderer::Acquire(%s, %d) ignored: the shared renderer was initialized with (%s, %d)"),
+			*PluginBaseDir, static_cast<int32>(AccessPattern), *GSharedRendererBaseDir, static_cast<int32>(GSharedRendererAccessPattern));
+	}
+
+	++GSharedRendererRefCount;
+	return GSharedRenderer;
+}
+
+void FULUERenderer::Release(TSharedPtr<FULUERenderer>& InOutRenderer)
+{
+	check(IsInGameThread());
+
+	if (!InOutRenderer.IsValid())
+	{
+		return;
+	}
+
+	ensure(InOutRenderer == GSharedRenderer && GSharedRendererRefCount > 0);
+	InOutRenderer.Reset();
+
+	if (--GSharedRendererRefCount == 0 && GSharedRenderer.IsValid())
+	{
+		GSharedRenderer->Shutdown();
+		GSharedRenderer.Reset();
+	}
+}
+
 bool FULUERenderer::Initialize(const FString& PluginBaseDir, FSAccess AccessPattern, ULUELogInterface* InLogInterface)
 {
 	if (Renderer.get())
@@ -216,6 +831,20 @@ bool FULUERenderer::Initialize(const FString& PluginBaseDir, FSAccess AccessPatt
 	FileSystem->SetBaseDirectory(UiContentRoot);
 	FileSystem->SetResourceDirectory(ResourceRoot);
 	FileSystem->SetFSAccess(AccessPattern);
+	FileSystem->LoadReadaheadManifest(
+		FPaths::Combine(CachePath, TEXT("ReadaheadManifest.txt")),
+		FPaths::Combine(FPaths::GetPath(GetDefaultBundlePath()), TEXT("ReadaheadManifest.txt")));
+	if (AccessPattern == FSAccess::FSA_Package)
+	{
+		// Cooked builds prefer the UI bundle written by -run=UltralightBundle; loose files remain the fallback.
+		FileSystem->MountBundle(GetDefaultBundlePath());
+	}
+#if WITH_EDITOR
+	else if (CVarHotReload.GetValueOnGameThread())
+	{
+		HotReload = MakeUnique<FULUEHotReload>(*FileSystem);
+	}
+#endif
 
 	if (!InLogInterface)
 	{
@@ -235,7 +864,9 @@ bool FULUERenderer::Initialize(const FString& PluginBaseDir, FSAccess AccessPatt
 	Config.face_winding = ultralight::FaceWinding::Clockwise; // UE/D3D uses clockwise front faces.
 	Platform.set_config(Config);
 
-	Platform.set_font_loader(ultralight::GetPlatformFontLoader());
+	// Fonts shipped under uicontent/fonts come from memory; system fonts only for families the project lacks.
+	FontLoader = MakeUnique<ULUEFontLoader>(*FileSystem);
+	Platform.set_font_loader(FontLoader.Get());
 	Platform.set_file_system(FileSystem.Get());
 	Platform.set_gpu_driver(GPUDriver.Get());
 	Platform.set_surface_factory(ultralight::GetBitmapSurfaceFactory());
@@ -250,11 +881,20 @@ bool FULUERenderer::Initialize(const FString& PluginBaseDir, FSAccess AccessPatt
 
 	UE_LOG(LogUltralightUE, Log, TEXT("Ultralight Renderer initialized: %s"), Renderer.get() ? TEXT("Success") : TEXT("Failed"));
 
+	if (Renderer.get())
+	{
+		GLiveRenderers.Add(this);
+		RegisterMemoryPressureHandlers();
+	}
+
 	return Renderer.get() != nullptr;
 }
 
 void FULUERenderer::Tick(float DeltaTime)
 {
+	ULUE_SCOPE_CYCLE_COUNTER(Tick);
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight Tick (%d views)"), Views.Num()));
+
 	if (!Renderer.get() || !Session.get())
 	{
 		return;
@@ -263,30 +903,98 @@ void FULUERenderer::Tick(float DeltaTime)
 	// Prune dead views first
 	PruneDeadViews();
 
+	const EULUEPurgeReason PurgeReason = PendingPurgeReason.exchange(EULUEPurgeReason::None);
+	if (PurgeReason != EULUEPurgeReason::None)
+	{
+		PurgeMemory(PurgeReason);
+	}
+	RecordCsvCounters(Views.Num());
+	PublishUltralightAllocatorStats();
+
 	// Only tick renderer if we have active views
 	if (Views.Num() == 0)
 	{
 		return;
 	}
 
-	// Safely update renderer
-	Renderer->Update();
-	Renderer->Render();
-
-	// Paint each view - copy views array to avoid issues during iteration
-	TArray<TWeakPtr<FULUEView>> ViewsCopy = Views;
-	for (const TWeakPtr<FULUEView>& WeakView : ViewsCopy)
+	// Pin views up front - copy views array to avoid issues during iteration
+	TArray<TSharedPtr<FULUEView>> LiveViews;
+	LiveViews.Reserve(Views.Num());
+	for (const TWeakPtr<FULUEView>& WeakView : Views)
 	{
 		if (TSharedPtr<FULUEView> View = WeakView.Pin())
 		{
-			View->PaintIfNeeded();
+			LiveViews.Add(MoveTemp(View));
+		}
+	}
+
+	EnforceViewBudget(LiveViews);
+#if WITH_EDITOR
+	if (HotReload.IsValid())
+	{
+		HotReload->Apply(LiveViews);
+	}
+#endif
+
+	// Hand the page this frame's UE-side changes before its timers and rAF callbacks run in Update.
+	{
+		ULUE_SCOPE_CYCLE_COUNTER(ScriptFlush);
+		for (const TSharedPtr<FULUEView>& View : LiveViews)
+		{
+			View->FlushScriptBridge();
 		}
 	}
+
+	// Update is shared work (timers, JS, layout for every view); attribute it evenly.
+	float UpdateShareMs = 0.0f;
+	{
+		ULUE_SCOPE_CYCLE_COUNTER(Update);
+		const uint64 UpdateStart = FPlatformTime::Cycles64();
+		Renderer->Update();
+		UpdateShareMs = LiveViews.Num() > 0
+			? static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - UpdateStart)) / LiveViews.Num()
+			: 0.0f;
+	}
+
+	// Render views one at a time so each view's raster cost is measured separately.
+	{
+		ULUE_SCOPE_CYCLE_COUNTER(Render);
+		for (const TSharedPtr<FULUEView>& View : LiveViews)
+		{
+			View->Render(*Renderer, UpdateShareMs);
+		}
+	}
+
+	for (const TSharedPtr<FULUEView>& View : LiveViews)
+	{
+		View->PaintIfNeeded();
+	}
+
+	// Accelerated views: replay this frame's command lists and resolves as one render graph.
+	GPUDriver->Submit();
 }
 
 void FULUERenderer::Shutdown()
 {
+	UnregisterMemoryPressureHandlers();
+	GLiveRenderers.Remove(this);
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	// Wrappers may outlive the renderer (their UObjects are collected later); make sure none keeps a native view.
+	for (const TWeakPtr<FULUEView>& WeakView : Views)
+	{
+		if (TSharedPtr<FULUEView> View = WeakView.Pin())
+		{
+			View->Detach();
+		}
+	}
 	Views.Empty();
+	NamedSessions.Empty();
 	Session = ultralight::RefPtr<ultralight::Session>();
 	Renderer = ultralight::RefPtr<ultralight::Renderer>();
 
@@ -297,6 +1005,10 @@ void FULUERenderer::Shutdown()
 	Platform.set_font_loader(nullptr);
 	Platform.set_surface_factory(nullptr);
 
+#if WITH_EDITOR
+	HotReload.Reset();
+#endif
+	FontLoader.Reset();
 	FileSystem.Reset();
 	GPUDriver.Reset();
 	OwnedLogInterface.Reset();
@@ -305,18 +1017,26 @@ void FULUERenderer::Shutdown()
 	UE_LOG(LogUltralightUE, Log, TEXT("Ultralight Renderer shut down"));
 }
 
-TSharedPtr<FULUEView> FULUERenderer::CreateView(const FIntPoint& Size, bool bTransparent, const FString& InitialURL, UObject* Outer, UTextureRenderTarget2D* ExistingRenderTarget)
+TSharedPtr<FULUEView> FULUERenderer::CreateView(const FIntPoint& Size, bool bTransparent, const FString& InitialURL, UObject* Outer, UTextureRenderTarget2D* ExistingRenderTarget, bool bAccelerated, const ultralight::RefPtr<ultralight::Session>& InSession)
 {
 	if (!Renderer || !Outer)
 	{
 		return nullptr;
 	}
 
+	if (bAccelerated && !FApp::CanEverRender())
+	{
+		UE_LOG(LogUltralightUE, Warning, TEXT("Accelerated view requested without a renderer, falling back to CPU rendering"));
+		bAccelerated = false;
+	}
+
 	ultralight::ViewConfig ViewConfig;
 	ViewConfig.is_transparent = bTransparent;
-	ViewConfig.is_accelerated = false; // CPU renderer so we can copy bitmap data to UE.
+	// CPU views paint into a BitmapSurface we copy to UE; accelerated views draw through ULUEGPUDriver.
+	ViewConfig.is_accelerated = bAccelerated;
 
-	ultralight::RefPtr<ultralight::View> NativeView = Renderer->CreateView(Size.X, Size.Y, ViewConfig, Session);
+	const ultralight::RefPtr<ultralight::Session> ViewSession = InSession ? InSession : Session;
+	ultralight::RefPtr<ultralight::View> NativeView = CreateNativeView(Size, ViewConfig, ViewSession);
 	if (!NativeView)
 	{
 		return nullptr;
@@ -335,7 +1055,7 @@ TSharedPtr<FULUEView> FULUERenderer::CreateView(const FIntPoint& Size, bool bTra
 	UULUERenderTarget* TargetWrapper = NewObject<UULUERenderTarget>(Outer);
 	TargetWrapper->Initialize(RenderTarget);
 
-	TSharedPtr<FULUEView> View = MakeShared<FULUEView>(AsShared(), NativeView, TargetWrapper);
+	TSharedPtr<FULUEView> View = MakeShared<FULUEView>(AsShared(), NativeView, TargetWrapper, ViewConfig, ViewSession);
 	if (View.IsValid() && !InitialURL.IsEmpty())
 	{
 		View->LoadURL(InitialURL);
@@ -345,6 +1065,82 @@ TSharedPtr<FULUEView> FULUERenderer::CreateView(const FIntPoint& Size, bool bTra
 	return View;
 }
 
+ultralight::RefPtr<ultralight::View> FULUERenderer::CreateNativeView(const FIntPoint& Size, const ultralight::ViewConfig& Config, const ultralight::RefPtr<ultralight::Session>& InSession)
+{
+	if (!Renderer)
+	{
+		return nullptr;
+	}
+	return Renderer->CreateView(Size.X, Size.Y, Config, InSession ? InSession : Session);
+}
+
+ultralight::RefPtr<ultralight::Session> FULUERenderer::CreateSession(bool bPersistent, const FString& Name)
+{
+	if (!Renderer)
+	{
+		return nullptr;
+	}
+	return Renderer->CreateSession(bPersistent, ToUltralightString(Name));
+}
+
+ultralight::RefPtr<ultralight::Session> FULUERenderer::FindOrCreateSession(const FString& Name, bool bPersistent)
+{
+	if (ultralight::RefPtr<ultralight::Session> Existing = FindSession(Name))
+	{
+		if (Existing->is_persistent() != bPersistent)
+		{
+			UE_LOG(LogUltralightUE, Warning, TEXT("Session '%s' already exists as %s; ignoring the requested persistence"),
+				*Name, Existing->is_persistent() ? TEXT("persistent") : TEXT("in-memory"));
+		}
+		return Existing;
+	}
+
+	// The name becomes a directory under the cache path for persistent sessions.
+	if (!Renderer || Name.IsEmpty() || FPaths::MakeValidFileName(Name) != Name)
+	{
+		UE_LOG(LogUltralightUE, Warning, TEXT("Cannot create Ultralight session '%s'"), *Name);
+		return nullptr;
+	}
+
+	ultralight::RefPtr<ultralight::Session> NewSession = CreateSession(bPersistent, Name);
+	if (NewSession)
+	{
+		NamedSessions.Add(Name, NewSession);
+		const FString DiskPath = bPersistent ? FString(UTF8_TO_TCHAR(NewSession->disk_path().utf8().data())) : FString(TEXT("memory"));
+		UE_LOG(LogUltralightUE, Log, TEXT("Created Ultralight session '%s' (%s)"), *Name, *DiskPath);
+	}
+	return NewSession;
+}
+
+ultralight::RefPtr<ultralight::Session> FULUERenderer::FindSession(const FString& Name) const
+{
+	const ultralight::RefPtr<ultralight::Session>* Found = NamedSessions.Find(Name);
+	return Found ? *Found : nullptr;
+}
+
+void FULUERenderer::DestroyViewsInSession(const ultralight::RefPtr<ultralight::Session>& InSession)
+{
+	if (!InSession)
+	{
+		return;
+	}
+
+	Views.RemoveAll([&InSession](const TWeakPtr<FULUEView>& Candidate)
+	{
+		TSharedPtr<FULUEView> View = Candidate.Pin();
+		if (!View.IsValid())
+		{
+			return true;
+		}
+		if (View->GetSession().get() != InSession.get())
+		{
+			return false;
+		}
+		View->Detach();
+		return true;
+	});
+}
+
 void FULUERenderer::DestroyView(const TSharedPtr<FULUEView>& View)
 {
 	if (!View.IsValid())
@@ -358,6 +1154,188 @@ void FULUERenderer::DestroyView(const TSharedPtr<FULUEView>& View)
 	});
 }
 
+TArray<FULUEViewTimings> FULUERenderer::GetViewTimings(const ultralight::Session* InSession) const
+{
+	TArray<FULUEViewTimings> Result;
+	Result.Reserve(Views.Num());
+	for (const TWeakPtr<FULUEView>& WeakView : Views)
+	{
+		TSharedPtr<FULUEView> View = WeakView.Pin();
+		if (View.IsValid() && (!InSession || View->GetSession().get() == InSession))
+		{
+			Result.Add(View->GetTimings());
+		}
+	}
+	return Result;
+}
+
+void FULUERenderer::PurgeMemory(EULUEPurgeReason Reason)
+{
+	if (!Renderer.get())
+	{
+		return;
+	}
+
+	const TCHAR* ReasonName = PurgeReasonToString(Reason);
+	ULUE_TRACE_SCOPE(FString::Printf(TEXT("Ultralight PurgeMemory (%s)"), ReasonName));
+	const int64 StagingBefore = GetTrackedMemory(EULUEMemoryCounter::Staging);
+
+	// Freeze first so PurgeMemory also reclaims what the destroyed views leave behind.
+	const bool bFreezeViews = Reason >= EULUEPurgeReason::MemoryTrim && CVarFreezeViewsOnMemoryPressure.GetValueOnGameThread();
+	int32 FrozenCount = 0;
+	for (const TWeakPtr<FULUEView>& WeakView : Views)
+	{
+		if (TSharedPtr<FULUEView> View = WeakView.Pin())
+		{
+			if (bFreezeViews && View->CanAutoFreeze() && View->Freeze())
+			{
+				++FrozenCount;
+			}
+			View->ReleaseTransientMemory();
+		}
+	}
+
+	Renderer->PurgeMemory();
+	if (FileSystem.IsValid())
+	{
+		FileSystem->TrimCaches();
+	}
+	if (GPUDriver.IsValid())
+	{
+		GPUDriver->Trim();
+	}
+
+	UE_LOG(LogUltralightUE, Log, TEXT("Purged Ultralight memory (%s): froze %d views, released %lld KB of staging buffers"),
+		ReasonName, FrozenCount, (StagingBefore - GetTrackedMemory(EULUEMemoryCounter::Staging)) / 1024);
+}
+
+void FULUERenderer::LogMemoryUsage()
+{
+	if (!Renderer.get())
+	{
+		return;
+	}
+
+	// Ultralight writes its breakdown through the platform logger, which forwards to LogUltralightUE.
+	Renderer->LogMemoryUsage();
+
+	UE_LOG(LogUltralightUE, Display, TEXT("Plugin memory: %d views, render targets %lld KB, staging %lld KB, file buffers %lld KB, mapped files %lld KB"),
+		Views.Num(),
+		GetTrackedMemory(EULUEMemoryCounter::RenderTarget) / 1024,
+		GetTrackedMemory(EULUEMemoryCounter::Staging) / 1024,
+		GetTrackedMemory(EULUEMemoryCounter::FileBuffers) / 1024,
+		GetTrackedMemory(EULUEMemoryCounter::MappedFiles) / 1024);
+
+	if (IsUltralightAllocatorInstalled())
+	{
+		const FULUEAllocatorStats Heap = GetUltralightAllocatorStats(EULUEAllocCategory::Heap);
+		const FULUEAllocatorStats Aligned = GetUltralightAllocatorStats(EULUEAllocCategory::Aligned);
+		UE_LOG(LogUltralightUE, Display, TEXT("Library heap: %lld KB live / %lld KB peak, aligned: %lld KB live / %lld KB peak, %lld allocations"),
+			Heap.LiveBytes / 1024, Heap.PeakBytes / 1024, Aligned.LiveBytes / 1024, Aligned.PeakBytes / 1024,
+			Heap.LiveAllocations + Aligned.LiveAllocations);
+	}
+}
+
+void FULUERenderer::RequestPurge(EULUEPurgeReason Reason)
+{
+	// Keep the most severe request if several arrive before the next tick.
+	EULUEPurgeReason Current = PendingPurgeReason.load();
+	while (Reason > Current && !PendingPurgeReason.compare_exchange_weak(Current, Reason))
+	{
+	}
+}
+
+void FULUERenderer::RegisterMemoryPressureHandlers()
+{
+	// Memory warnings (mobile low-memory, platform trim requests) and OOM can arrive off the game thread,
+	// so they only flag a purge. A level transition is a natural point to drop the previous level's UI caches.
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddSP(this, &FULUERenderer::RequestPurge, EULUEPurgeReason::MemoryTrim);
+	OutOfMemoryHandle = FCoreDelegates::GetOutOfMemoryDelegate().AddSP(this, &FULUERenderer::RequestPurge, EULUEPurgeReason::OutOfMemory);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddSPLambda(this, [this](UWorld*)
+	{
+		RequestPurge(EULUEPurgeReason::LevelTransition);
+	});
+}
+
+void FULUERenderer::UnregisterMemoryPressureHandlers()
+{
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+	FCoreDelegates::GetOutOfMemoryDelegate().Remove(OutOfMemoryHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	MemoryTrimHandle.Reset();
+	OutOfMemoryHandle.Reset();
+	PostLoadMapHandle.Reset();
+	PendingPurgeReason.store(EULUEPurgeReason::None);
+}
+
+void FULUERenderer::EnforceViewBudget(const TArray<TSharedPtr<FULUEView>>& LiveViews)
+{
+	const int32 MaxActiveViews = CVarMaxActiveViews.GetValueOnGameThread();
+	const int64 BudgetBytes = static_cast<int64>(CVarMemoryBudgetMB.GetValueOnGameThread()) * 1024 * 1024;
+	if (MaxActiveViews <= 0 && BudgetBytes <= 0)
+	{
+		return;
+	}
+
+	int32 ActiveViews = 0;
+	int64 ViewBytes = 0;
+	TArray<FULUEView*, TInlineAllocator<16>> Candidates;
+	for (const TSharedPtr<FULUEView>& View : LiveViews)
+	{
+		if (View->IsFrozen())
+		{
+			continue;
+		}
+		++ActiveViews;
+		ViewBytes += View->GetEstimatedNativeBytes();
+		if (View->CanAutoFreeze())
+		{
+			Candidates.Add(View.Get());
+		}
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return;
+	}
+
+	// With the allocator override we can measure the real library heap, but it only drops once the
+	// frozen view is torn down, so freeze at most one view per tick in that mode and re-measure.
+	const bool bMeasureHeap = IsUltralightAllocatorInstalled();
+	int64 UsedBytes = bMeasureHeap ? GetUltralightAllocatorStats().LiveBytes : ViewBytes;
+
+	Candidates.Sort([](const FULUEView& A, const FULUEView& B)
+	{
+		return A.GetLastUsedTime() < B.GetLastUsedTime();
+	});
+
+	for (FULUEView* Candidate : Candidates)
+	{
+		const bool bOverCount = MaxActiveViews > 0 && ActiveViews > MaxActiveViews;
+		const bool bOverBudget = BudgetBytes > 0 && UsedBytes > BudgetBytes;
+		if (!bOverCount && !bOverBudget)
+		{
+			break;
+		}
+
+		const int64 CandidateBytes = Candidate->GetEstimatedNativeBytes();
+		if (!Candidate->Freeze())
+		{
+			continue;
+		}
+
+		--ActiveViews;
+		if (!bMeasureHeap)
+		{
+			UsedBytes -= CandidateBytes;
+		}
+		else if (MaxActiveViews <= 0 || ActiveViews <= MaxActiveViews)
+		{
+			break;
+		}
+	}
+}
+
 void FULUERenderer::PruneDeadViews()
 {
 	Views.RemoveAll([](const TWeakPtr<FULUEView>& Candidate)
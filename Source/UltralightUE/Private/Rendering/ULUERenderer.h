@@ -7,33 +7,103 @@
 
 #include "CoreMinimal.h"
 #include "Templates/SharedPointer.h"
+#include "Containers/Ticker.h"
 #include "FileSystem/ULUEFileSystem.h"
 #include "ULUELogInterface.h"
 #include "ULUEUltralightIncludes.h"
+#include "ULUEStats.h"
+#include "ULUETrace.h"
+#include "Rendering/ULUEView.h"
+#include "Scripting/ULUEJSBridge.h"
+#include <atomic>
 
 class UTextureRenderTarget2D;
 class UULUERenderTarget;
+class FULUEHotReload;
 
 namespace ultralightue
 {
 	class ULUEGPUDriver;
+	class ULUEFontLoader;
 }
 
+/** What FULUEView::ApplyContentChanges did with a batch of changed files. */
+enum class EULUEHotReloadResult : uint8
+{
+	None,
+	SwappedStylesheets,
+	Reloaded
+};
+
 /**
- * Internal Ultralight View wrapper. Copies bitmap surfaces into a UE render target.
+ * Internal Ultralight View wrapper. CPU views copy bitmap surfaces into a UE render target;
+ * accelerated views resolve their GPU render target into it through the GPU driver.
  */
 class FULUEView : public TSharedFromThis<FULUEView>
 {
 public:
-	FULUEView(const TWeakPtr<class FULUERenderer>& InOwner, ultralight::RefPtr<ultralight::View> InView, UULUERenderTarget* InTarget);
+	FULUEView(const TWeakPtr<class FULUERenderer>& InOwner, ultralight::RefPtr<ultralight::View> InView, UULUERenderTarget* InTarget, const ultralight::ViewConfig& InConfig, const ultralight::RefPtr<ultralight::Session>& InSession);
 	~FULUEView();
 
 	void LoadURL(const FString& URL);
 	void LoadHTML(const FString& HTML, const FString& VirtualURL = TEXT("about:blank"));
 	void Resize(const FIntPoint& InSize);
-	void SetFocused(bool bFocused);
+	void SetFocused(bool bInFocused);
 	void PaintIfNeeded();
 
+	/// @brief Drops per-view CPU buffers that are rebuilt on the next paint.
+	void ReleaseTransientMemory();
+
+	/// @brief Destroys the native view (DOM, JS heap, surface) but keeps the last frame in the render target.
+	/// JS state is lost; Thaw() reloads the last URL/HTML and restores scroll position and focus.
+	bool Freeze();
+	bool Thaw();
+	bool IsFrozen() const { return bFrozen; }
+
+	/// @brief Allows the renderer's view budget and memory-pressure handling to freeze this view.
+	void SetAutoFreeze(bool bInAutoFreeze) { bAutoFreeze = bInAutoFreeze; }
+	/// @brief True if auto-freeze is enabled and the view is loaded, painted and unfocused.
+	bool CanAutoFreeze() const;
+
+	/// @brief FPlatformTime::Seconds() of the last load, focus or input; drives LRU freezing.
+	double GetLastUsedTime() const { return LastUsedTime; }
+
+	/// @brief Surface (or GPU render buffer) bytes held by the native view; 0 while frozen.
+	int64 GetEstimatedNativeBytes() const;
+
+	/// @brief Session the view was created in (and is re-created in by Thaw).
+	const ultralight::RefPtr<ultralight::Session>& GetSession() const { return Session; }
+
+	/// @brief Picks up edited UI files (paths relative to uicontent, caches already invalidated). Changed stylesheets
+	/// are swapped in place through injected JS; any other file the page depends on reloads it, keeping scroll.
+	/// bReloadAll reloads regardless, for changes the directory watcher couldn't pin down.
+	EULUEHotReloadResult ApplyContentChanges(const TSet<FString>& ChangedFiles, bool bReloadAll);
+
+	/// @brief Exposes Buffer to the page as `ue.buffers[Name]`; kept across reloads, freezes and thaws.
+	void PublishBuffer(const FString& Name, const FULUEJSBufferRef& Buffer);
+	void UnpublishBuffer(const FString& Name);
+	/// @brief Makes Callback callable from the page as `ue.<Name>()`; kept across reloads, freezes and thaws.
+	void BindFunction(const FString& Name, FULUEJSCallback&& Callback);
+	void UnbindFunction(const FString& Name);
+	/// @brief Queues a call to a page function for the start of the next tick; thaws a frozen view.
+	void EnqueueCall(const FString& Function, TArray<FULUEJSValue>&& Args);
+	/// @brief Pushes script-side changes and queued calls into the page; called before Renderer::Update.
+	void FlushScriptBridge();
+
+	/// @brief Releases the native view for good, e.g. when its session's owner goes away.
+	/// Further calls on this wrapper are no-ops.
+	void Detach();
+
+	/// @brief Renders only this view (Renderer::RenderOnly) so its raster cost can be attributed to it.
+	void Render(ultralight::Renderer& Renderer, float UpdateShareMs);
+
+	/// @brief Name used for stats and Insights. Falls back to the last loaded URL when empty.
+	void SetDebugName(const FString& InDebugName);
+	const FULUEViewTimings& GetTimings() const { return Timings; }
+
+	/// @brief Process-unique ID used to correlate trace events with this view.
+	uint32 GetViewId() const { return ViewId; }
+
 	void InjectMouseEvent(ultralight::MouseEvent::Type Type, const FVector2D& Position, ultralight::MouseEvent::Button Button, uint32 Modifiers);
 	void InjectScroll(const FVector2D& ScrollDelta, bool bByPage, uint32 Modifiers);
 	void InjectKeyEvent(const ultralight::KeyEvent& Event);
@@ -44,36 +114,132 @@ public:
 
 private:
 	void CopySurfaceToTarget();
+	void ResolveRenderTarget(bool bForceRender);
+	void RefreshStatName();
+	void Touch();
+	/// Stores the page's scroll offset in FrozenScroll for restoring after a reload.
+	void CaptureScroll();
+	/// Thaws a frozen view before input or a resize reaches it.
+	bool EnsureThawed();
+	/// Prefetches URL's recorded dependencies and records them again until the load finishes (see ULUEFileSystem::BeginPageLoad).
+	void BeginReadahead(const FString& URL);
+	void EndReadahead(bool bCommit);
 
 	TWeakPtr<class FULUERenderer> Owner;
 	ultralight::RefPtr<ultralight::View> View;
 	TWeakObjectPtr<UULUERenderTarget> Target;
 	FIntPoint Size;
 	int32 FramesSinceCreation = 0;
+	uint32 ViewId = 0;
+
+	FString DebugName;
+	FString LastURL;
+	FULUEViewTimings Timings;
+
+	// Everything Thaw() needs to rebuild the native view.
+	ultralight::ViewConfig Config;
+	ultralight::RefPtr<ultralight::Session> Session;
+	FString LastHTML;
+	bool bLastLoadWasHTML = false;
+	FVector2D FrozenScroll = FVector2D::ZeroVector;
+	bool bPendingScrollRestore = false;
+	bool bFocused = false;
+	bool bFrozen = false;
+	/// Keeps the frozen frame on screen until the thawed view has finished loading.
+	bool bThawing = false;
+	bool bAutoFreeze = false;
+	double LastUsedTime = 0.0;
+	/// Listens to the native view's loads; outlives it across freezes so published state survives.
+	TUniquePtr<FULUEJSBridge> ScriptBridge;
+	/// Page being recorded for the readahead manifest; empty when not recording.
+	FString ReadaheadURL;
+	TStatId StageStatIds[static_cast<int32>(ultralightue::EULUEViewStage::Num)];
+	FString StageEventNames[static_cast<int32>(ultralightue::EULUEViewStage::Num)];
+};
+
+/** Why FULUERenderer::PurgeMemory runs, in increasing severity. */
+enum class EULUEPurgeReason : uint8
+{
+	None,
+	Manual,
+	LevelTransition,
+	/// Platform memory warning (FCoreDelegates::GetMemoryTrimDelegate).
+	MemoryTrim,
+	OutOfMemory
 };
 
 /**
  * Manages Ultralight renderer lifecycle and ticking.
+ * Ultralight's Platform is a process-wide singleton, so game code shares one renderer through
+ * Acquire/Release and isolates itself with its own session (cookies, storage, cache).
  */
 class FULUERenderer : public TSharedFromThis<FULUERenderer>
 {
 public:
+	/// @brief Returns the shared renderer, creating and initializing it for the first reference.
+	/// Only the first caller's arguments take effect; later callers must pass the same ones (ensured).
+	/// The shared renderer ticks itself on the core ticker. Game thread only.
+	static TSharedPtr<FULUERenderer> Acquire(const FString& PluginBaseDir, ultralightue::FSAccess AccessPattern);
+
+	/// @brief Drops one reference taken by Acquire and resets InOutRenderer. The last release shuts the
+	/// renderer down and clears the Platform singleton.
+	static void Release(TSharedPtr<FULUERenderer>& InOutRenderer);
+
 	bool Initialize(const FString& PluginBaseDir, ultralightue::FSAccess AccessPattern, ultralightue::ULUELogInterface* InLogInterface = nullptr);
 	void Tick(float DeltaTime);
 	void Shutdown();
 
-	TSharedPtr<FULUEView> CreateView(const FIntPoint& Size, bool bTransparent, const FString& InitialURL, UObject* Outer, UTextureRenderTarget2D* ExistingRenderTarget = nullptr);
+	/// @brief Creates a view in InSession, or in the renderer's default session when InSession is null.
+	TSharedPtr<FULUEView> CreateView(const FIntPoint& Size, bool bTransparent, const FString& InitialURL, UObject* Outer, UTextureRenderTarget2D* ExistingRenderTarget = nullptr, bool bAccelerated = false, const ultralight::RefPtr<ultralight::Session>& InSession = nullptr);
 	void DestroyView(const TSharedPtr<FULUEView>& View);
 
+	/// @brief Creates a bare native view; used by CreateView and FULUEView::Thaw.
+	ultralight::RefPtr<ultralight::View> CreateNativeView(const FIntPoint& Size, const ultralight::ViewConfig& Config, const ultralight::RefPtr<ultralight::Session>& InSession);
+
+	/// @brief Creates a session with its own cookies, localStorage and cache (Renderer::CreateSession).
+	ultralight::RefPtr<ultralight::Session> CreateSession(bool bPersistent, const FString& Name);
+
+	/// @brief Returns the named session, creating it on first use. Named sessions are shared by every client
+	/// of the renderer. Persistent ones keep cookies, localStorage and the HTTP cache on disk under the cache
+	/// path (Saved/UltralightCache), so they survive restarts. Names must be valid file names.
+	ultralight::RefPtr<ultralight::Session> FindOrCreateSession(const FString& Name, bool bPersistent);
+	ultralight::RefPtr<ultralight::Session> FindSession(const FString& Name) const;
+
+	/// @brief Detaches every view created in InSession; views in other sessions are untouched.
+	void DestroyViewsInSession(const ultralight::RefPtr<ultralight::Session>& InSession);
+
+	/// @brief Last-frame timings of every live view, optionally only those in InSession.
+	TArray<FULUEViewTimings> GetViewTimings(const ultralight::Session* InSession = nullptr) const;
+
+	/// @brief Frees Ultralight's caches (Renderer::PurgeMemory), trims the GPU driver and drops view staging
+	/// buffers. Memory warnings also freeze auto-freeze views (Ultralight.FreezeViewsOnMemoryPressure).
+	/// Game thread only; memory-pressure notifications defer here through the next Tick.
+	void PurgeMemory(EULUEPurgeReason Reason);
+
+	/// @brief Writes Ultralight's memory breakdown (Renderer::LogMemoryUsage) and the plugin's own counters to the log.
+	void LogMemoryUsage();
+
 	bool IsInitialized() const { return Renderer.get() != nullptr; }
 	const FString& GetResourceRoot() const { return ResourceRoot; }
+	ultralightue::ULUEGPUDriver* GetGPUDriver() const { return GPUDriver.Get(); }
+	ultralightue::ULUEFileSystem* GetFileSystem() const { return FileSystem.Get(); }
 
 private:
     void PruneDeadViews();
+    /// Freezes least-recently-used auto-freeze views while over Ultralight.MaxActiveViews / Ultralight.MemoryBudgetMB.
+    void EnforceViewBudget(const TArray<TSharedPtr<FULUEView>>& LiveViews);
+    void RegisterMemoryPressureHandlers();
+    void UnregisterMemoryPressureHandlers();
+    /// Callable from any thread; the purge itself runs at the start of the next Tick.
+    void RequestPurge(EULUEPurgeReason Reason);
 
     TUniquePtr<ultralightue::ULUEFileSystem> FileSystem;
     TUniquePtr<ultralightue::ULUELogInterface> OwnedLogInterface;
     TUniquePtr<ultralightue::ULUEGPUDriver> GPUDriver;
+    TUniquePtr<ultralightue::ULUEFontLoader> FontLoader;
+#if WITH_EDITOR
+    TUniquePtr<FULUEHotReload> HotReload;
+#endif
     ultralightue::ULUEILoggerInterface* LoggerBridge = nullptr;
 
 	ultralight::RefPtr<ultralight::Renderer> Renderer;
@@ -83,4 +249,13 @@ private:
 
 	FString ResourceRoot;
 	FString CachePath;
+
+	TMap<FString, ultralight::RefPtr<ultralight::Session>> NamedSessions;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	std::atomic<EULUEPurgeReason> PendingPurgeReason{ EULUEPurgeReason::None };
+	FDelegateHandle MemoryTrimHandle;
+	FDelegateHandle OutOfMemoryHandle;
+	FDelegateHandle PostLoadMapHandle;
 };
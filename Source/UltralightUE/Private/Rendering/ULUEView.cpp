@@ -58,6 +58,91 @@ void UUltralightView::SetFocused(bool bFocused)
 	}
 }
 
+FString UUltralightView::GetSessionName() const
+{
+	if (!NativeView.IsValid() || !NativeView->GetSession())
+	{
+		return FString();
+	}
+	return FString(UTF8_TO_TCHAR(NativeView->GetSession()->name().utf8().data()));
+}
+
+bool UUltralightView::Freeze()
+{
+	return NativeView.IsValid() && NativeView->Freeze();
+}
+
+bool UUltralightView::Thaw()
+{
+	return NativeView.IsValid() && NativeView->Thaw();
+}
+
+bool UUltralightView::IsFrozen() const
+{
+	return NativeView.IsValid() && NativeView->IsFrozen();
+}
+
+void UUltralightView::SetAutoFreeze(bool bAutoFreeze)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->SetAutoFreeze(bAutoFreeze);
+	}
+}
+
+void UUltralightView::SetDebugName(const FString& DebugName)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->SetDebugName(DebugName);
+	}
+}
+
+FULUEViewTimings UUltralightView::GetTimings() const
+{
+	return NativeView.IsValid() ? NativeView->GetTimings() : FULUEViewTimings();
+}
+
+void UUltralightView::PublishBuffer(const FString& Name, const FULUEJSBufferRef& Buffer)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->PublishBuffer(Name, Buffer);
+	}
+}
+
+void UUltralightView::UnpublishBuffer(const FString& Name)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->UnpublishBuffer(Name);
+	}
+}
+
+void UUltralightView::BindFunction(const FString& Name, FULUEJSCallback Callback)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->BindFunction(Name, MoveTemp(Callback));
+	}
+}
+
+void UUltralightView::UnbindFunction(const FString& Name)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->UnbindFunction(Name);
+	}
+}
+
+void UUltralightView::EnqueueCall(const FString& Function, TArray<FULUEJSValue> Args)
+{
+	if (NativeView.IsValid())
+	{
+		NativeView->EnqueueCall(Function, MoveTemp(Args));
+	}
+}
+
 void UUltralightView::InjectMouseMove(const FVector2D& Position)
 {
 	if (NativeView.IsValid())
@@ -0,0 +1,529 @@
+/*
+ * Native bridge between UE and a view's JavaScript context (JavaScriptCore C API).
+ */
+
+#include "Scripting/ULUEJSBridge.h"
+#include "ULUELogInterface.h"
+#include "ULUEStats.h"
+
+namespace
+{
+	/// JSStringRef that releases itself.
+	struct FJSString
+	{
+		explicit FJSString(const char* Utf8)
+			: Ref(JSStringCreateWithUTF8CString(Utf8))
+		{
+		}
+
+		explicit FJSString(FStringView String)
+			: Ref(JSStringCreateWithCharacters(reinterpret_cast<const JSChar*>(String.GetData()), String.Len()))
+		{
+		}
+
+		~FJSString()
+		{
+			JSStringRelease(Ref);
+		}
+
+		FJSString(const FJSString&) = delete;
+		FJSString& operator=(const FJSString&) = delete;
+
+		operator JSStringRef() const { return Ref; }
+
+		JSStringRef Ref;
+	};
+
+	static_assert(sizeof(TCHAR) == sizeof(JSChar), "FString and JSString share UTF-16 storage");
+
+	FString ToFString(JSStringRef String)
+	{
+		return FString(static_cast<int32>(JSStringGetLength(String)), reinterpret_cast<const TCHAR*>(JSStringGetCharactersPtr(String)));
+	}
+
+	/// Property names written every tick; JSStrings are immutable, so one instance serves every view.
+	JSStringRef GetVersionKey()
+	{
+		static const JSStringRef Key = JSStringCreateWithUTF8CString("version");
+		return Key;
+	}
+
+	JSTypedArrayType ToJSTypedArrayType(EULUETypedArrayType Type)
+	{
+		switch (Type)
+		{
+		case EULUETypedArrayType::Int8:
+			return kJSTypedArrayTypeInt8Array;
+		case EULUETypedArrayType::Uint8Clamped:
+			return kJSTypedArrayTypeUint8ClampedArray;
+		case EULUETypedArrayType::Int16:
+			return kJSTypedArrayTypeInt16Array;
+		case EULUETypedArrayType::Uint16:
+			return kJSTypedArrayTypeUint16Array;
+		case EULUETypedArrayType::Int32:
+			return kJSTypedArrayTypeInt32Array;
+		case EULUETypedArrayType::Uint32:
+			return kJSTypedArrayTypeUint32Array;
+		case EULUETypedArrayType::Float32:
+			return kJSTypedArrayTypeFloat32Array;
+		case EULUETypedArrayType::Float64:
+			return kJSTypedArrayTypeFloat64Array;
+		default:
+			return kJSTypedArrayTypeUint8Array;
+		}
+	}
+
+	JSValueRef ToJSValue(JSContextRef Ctx, const FULUEJSValue& Value)
+	{
+		switch (Value.GetType())
+		{
+		case EULUEJSValueType::Null:
+			return JSValueMakeNull(Ctx);
+		case EULUEJSValueType::Boolean:
+			return JSValueMakeBoolean(Ctx, Value.AsBool());
+		case EULUEJSValueType::Number:
+			return JSValueMakeNumber(Ctx, Value.AsNumber());
+		case EULUEJSValueType::String:
+			return JSValueMakeString(Ctx, FJSString(Value.AsString()));
+		default:
+			return JSValueMakeUndefined(Ctx);
+		}
+	}
+
+	/// Primitives keep their type; objects and arrays become their JSON text.
+	FULUEJSValue FromJSValue(JSContextRef Ctx, JSValueRef Value)
+	{
+		switch (JSValueGetType(Ctx, Value))
+		{
+		case kJSTypeNull:
+			return FULUEJSValue::MakeNull();
+		case kJSTypeBoolean:
+			return FULUEJSValue(JSValueToBoolean(Ctx, Value));
+		case kJSTypeNumber:
+			return FULUEJSValue(JSValueToNumber(Ctx, Value, nullptr));
+		case kJSTypeUndefined:
+			return FULUEJSValue();
+		default:
+			break;
+		}
+
+		JSStringRef String = JSValueIsObject(Ctx, Value) ? JSValueCreateJSONString(Ctx, Value, 0, nullptr) : nullptr;
+		if (!String)
+		{
+			String = JSValueToStringCopy(Ctx, Value, nullptr);
+		}
+		if (!String)
+		{
+			return FULUEJSValue();
+		}
+		FULUEJSValue Result(ToFString(String));
+		JSStringRelease(String);
+		return Result;
+	}
+
+	void LogException(JSContextRef Ctx, const FString& Function, JSValueRef Exception)
+	{
+		FString Message = TEXT("(unknown)");
+		if (JSStringRef String = JSValueToStringCopy(Ctx, Exception, nullptr))
+		{
+			Message = ToFString(String);
+			JSStringRelease(String);
+		}
+		UE_LOG(LogUltralightUE, Warning, TEXT("JS call to '%s' threw: %s"), *Function, *Message);
+	}
+
+	/// Deallocator of a typed array over a FULUEJSBuffer: drops the reference the array held.
+	void ReleaseBufferReference(void* /*Bytes*/, void* Context)
+	{
+		delete static_cast<FULUEJSBufferPtr*>(Context);
+	}
+
+	/// Parent[Name] as an object, replacing whatever else is there with an empty one.
+	JSObjectRef GetOrCreateObject(JSContextRef Ctx, JSObjectRef Parent, const char* Name)
+	{
+		const FJSString Key(Name);
+		const JSValueRef Value = JSObjectGetProperty(Ctx, Parent, Key, nullptr);
+		if (Value && JSValueIsObject(Ctx, Value))
+		{
+			return JSValueToObject(Ctx, Value, nullptr);
+		}
+
+		const JSObjectRef Object = JSObjectMake(Ctx, nullptr, nullptr);
+		JSObjectSetProperty(Ctx, Parent, Key, Object, kJSPropertyAttributeNone, nullptr);
+		return Object;
+	}
+}
+
+FULUEJSBridge::~FULUEJSBridge()
+{
+	Detach();
+}
+
+void FULUEJSBridge::Attach(ultralight::View* InView)
+{
+	Detach();
+	View = InView;
+	if (View)
+	{
+		// Everything is exposed again when the page's window object is ready.
+		View->set_load_listener(this);
+	}
+}
+
+void FULUEJSBridge::Detach()
+{
+	if (!View)
+	{
+		return;
+	}
+
+	// Views can share a VM, so values protected for this page would outlive it; release them while the view is
+	// still alive. The typed arrays they keep reachable hold references to the UE buffers.
+	{
+		ultralight::RefPtr<ultralight::JSContext> Context = View->LockJSContext();
+		ReleaseFunctionCache(Context->ctx());
+		for (TPair<FString, FPublishedBuffer>& Pair : Buffers)
+		{
+			ReleaseHolder(Context->ctx(), Pair.Value);
+		}
+	}
+
+	View->set_load_listener(nullptr);
+	View = nullptr;
+	PendingCalls.Reset();
+}
+
+void FULUEJSBridge::PublishBuffer(const FString& Name, const FULUEJSBufferRef& Buffer)
+{
+	ultralight::RefPtr<ultralight::JSContext> Context = View ? View->LockJSContext() : nullptr;
+	if (FPublishedBuffer* Existing = Buffers.Find(Name))
+	{
+		if (Context)
+		{
+			ReleaseHolder(Context->ctx(), *Existing);
+		}
+		Buffers.Remove(Name);
+	}
+
+	FPublishedBuffer& Published = Buffers.Add(Name, FPublishedBuffer{ Buffer });
+	if (Context)
+	{
+		ExposeBuffer(Context->ctx(), Name, Published);
+	}
+}
+
+void FULUEJSBridge::UnpublishBuffer(const FString& Name)
+{
+	FPublishedBuffer* Published = Buffers.Find(Name);
+	if (!Published)
+	{
+		return;
+	}
+
+	if (View)
+	{
+		ultralight::RefPtr<ultralight::JSContext> Context = View->LockJSContext();
+		ReleaseHolder(Context->ctx(), *Published);
+		JSObjectDeleteProperty(Context->ctx(), GetBuffersObject(Context->ctx()), FJSString(Name), nullptr);
+	}
+	Buffers.Remove(Name);
+}
+
+void FULUEJSBridge::BindFunction(const FString& Name, FULUEJSCallback&& Callback)
+{
+	if (Name == TEXT("buffers"))
+	{
+		UE_LOG(LogUltralightUE, Warning, TEXT("Cannot bind native function 'ue.buffers': the name is reserved"));
+		return;
+	}
+
+	// The old callback may be running right now, so it is retired rather than replaced.
+	if (const FNativeFunctionRef* Existing = NativeFunctions.Find(Name))
+	{
+		(*Existing)->bUnbound = true;
+	}
+
+	const FNativeFunctionRef& Native = NativeFunctions.Add(Name, MakeShared<FNativeFunction, ESPMode::ThreadSafe>(FNativeFunction{ Name, MoveTemp(Callback) }));
+	if (View)
+	{
+		ultralight::RefPtr<ultralight::JSContext> Context = View->LockJSContext();
+		ExposeFunction(Context->ctx(), Native);
+	}
+}
+
+void FULUEJSBridge::UnbindFunction(const FString& Name)
+{
+	const FNativeFunctionRef* Native = NativeFunctions.Find(Name);
+	if (!Native)
+	{
+		return;
+	}
+
+	(*Native)->bUnbound = true;
+	NativeFunctions.Remove(Name);
+	if (View)
+	{
+		ultralight::RefPtr<ultralight::JSContext> Context = View->LockJSContext();
+		JSObjectDeleteProperty(Context->ctx(), GetUeObject(Context->ctx()), FJSString(Name), nullptr);
+	}
+}
+
+void FULUEJSBridge::EnqueueCall(const FString& Function, TArray<FULUEJSValue>&& Args)
+{
+	if (View)
+	{
+		PendingCalls.Add({ Function, MoveTemp(Args) });
+	}
+}
+
+void FULUEJSBridge::Flush()
+{
+	if (!View)
+	{
+		return;
+	}
+
+	// Only lock the context when there is something to write.
+	ultralight::RefPtr<ultralight::JSContext> Context;
+	for (TPair<FString, FPublishedBuffer>& Pair : Buffers)
+	{
+		FPublishedBuffer& Published = Pair.Value;
+		const uint32 Version = Published.Buffer->GetVersion();
+		if (!Published.Holder || Version == Published.PublishedVersion)
+		{
+			continue;
+		}
+
+		if (!Context)
+		{
+			Context = View->LockJSContext();
+		}
+		JSObjectSetProperty(Context->ctx(), Published.Holder, GetVersionKey(), JSValueMakeNumber(Context->ctx(), Version), kJSPropertyAttributeNone, nullptr);
+		Published.PublishedVersion = Version;
+	}
+
+	// Until the page has loaded, the functions it defines may not exist yet.
+	if (PendingCalls.Num() > 0 && !View->is_loading())
+	{
+		if (!Context)
+		{
+			Context = View->LockJSContext();
+		}
+		DispatchCalls(Context->ctx());
+	}
+}
+
+void FULUEJSBridge::DispatchCalls(JSContextRef Ctx)
+{
+	// Calls made from inside these (e.g. through native callbacks) run next tick.
+	TArray<FQueuedCall> Calls = MoveTemp(PendingCalls);
+	PendingCalls.Reset();
+
+	// Unprotected values are only kept alive by the collector's conservative stack scan, so arguments live in an
+	// inline buffer; the rare call with more than fits is protected explicitly.
+	constexpr int32 InlineArguments = 16;
+	TArray<JSValueRef, TInlineAllocator<InlineArguments>> Arguments;
+	for (const FQueuedCall& Call : Calls)
+	{
+		const FCachedFunction* Found = FindFunction(Ctx, Call.Function);
+		if (!Found)
+		{
+			UE_LOG(LogUltralightUE, Warning, TEXT("JS call to '%s' skipped: not a function"), *Call.Function);
+			continue;
+		}
+		// Copied: the call can run native callbacks that touch the cache.
+		const FCachedFunction Function = *Found;
+
+		const bool bProtect = Call.Args.Num() > InlineArguments;
+		Arguments.Reset();
+		for (const FULUEJSValue& Arg : Call.Args)
+		{
+			const JSValueRef Value = Arguments.Add_GetRef(ToJSValue(Ctx, Arg));
+			if (bProtect)
+			{
+				JSValueProtect(Ctx, Value);
+			}
+		}
+
+		JSValueRef Exception = nullptr;
+		JSObjectCallAsFunction(Ctx, Function.Function, Function.This, Arguments.Num(), Arguments.GetData(), &Exception);
+		if (bProtect)
+		{
+			for (const JSValueRef Value : Arguments)
+			{
+				JSValueUnprotect(Ctx, Value);
+			}
+		}
+		if (Exception)
+		{
+			LogException(Ctx, Call.Function, Exception);
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_UltralightJSCalls, Calls.Num());
+}
+
+const FULUEJSBridge::FCachedFunction* FULUEJSBridge::FindFunction(JSContextRef Ctx, const FString& Path)
+{
+	if (const FCachedFunction* Cached = FunctionCache.Find(Path))
+	{
+		return Cached;
+	}
+
+	FCachedFunction Resolved;
+	Resolved.Function = ResolveFunction(Ctx, Path, Resolved.This);
+	if (!Resolved.Function)
+	{
+		return nullptr;
+	}
+
+	JSValueProtect(Ctx, Resolved.Function);
+	JSValueProtect(Ctx, Resolved.This);
+	return &FunctionCache.Add(Path, Resolved);
+}
+
+void FULUEJSBridge::ReleaseFunctionCache(JSContextRef Ctx)
+{
+	for (const TPair<FString, FCachedFunction>& Pair : FunctionCache)
+	{
+		JSValueUnprotect(Ctx, Pair.Value.Function);
+		JSValueUnprotect(Ctx, Pair.Value.This);
+	}
+	FunctionCache.Reset();
+}
+
+JSObjectRef FULUEJSBridge::ResolveFunction(JSContextRef Ctx, FStringView Path, JSObjectRef& OutThis)
+{
+	JSObjectRef Object = JSContextGetGlobalObject(Ctx);
+	OutThis = nullptr;
+	for (;;)
+	{
+		int32 Dot = INDEX_NONE;
+		const bool bLast = !Path.FindChar(TEXT('.'), Dot);
+		const JSValueRef Value = JSObjectGetProperty(Ctx, Object, FJSString(bLast ? Path : Path.Left(Dot)), nullptr);
+		if (!Value || !JSValueIsObject(Ctx, Value))
+		{
+			return nullptr;
+		}
+
+		OutThis = Object;
+		Object = JSValueToObject(Ctx, Value, nullptr);
+		if (bLast)
+		{
+			break;
+		}
+		Path.RightChopInline(Dot + 1);
+	}
+	return JSObjectIsFunction(Ctx, Object) ? Object : nullptr;
+}
+
+void FULUEJSBridge::OnWindowObjectReady(ultralight::View* caller, uint64_t /*frame_id*/, bool is_main_frame, const ultralight::String& /*url*/)
+{
+	if (!is_main_frame || (Buffers.Num() == 0 && NativeFunctions.Num() == 0 && FunctionCache.Num() == 0))
+	{
+		return;
+	}
+
+	// Handles into the previous page are unreachable now; let the GC have them.
+	ultralight::RefPtr<ultralight::JSContext> Context = caller->LockJSContext();
+	ReleaseFunctionCache(Context->ctx());
+	for (TPair<FString, FPublishedBuffer>& Pair : Buffers)
+	{
+		ReleaseHolder(Context->ctx(), Pair.Value);
+		ExposeBuffer(Context->ctx(), Pair.Key, Pair.Value);
+	}
+	for (const TPair<FString, FNativeFunctionRef>& Pair : NativeFunctions)
+	{
+		ExposeFunction(Context->ctx(), Pair.Value);
+	}
+}
+
+JSObjectRef FULUEJSBridge::GetUeObject(JSContextRef Ctx)
+{
+	return GetOrCreateObject(Ctx, JSContextGetGlobalObject(Ctx), "ue");
+}
+
+JSObjectRef FULUEJSBridge::GetBuffersObject(JSContextRef Ctx)
+{
+	return GetOrCreateObject(Ctx, GetUeObject(Ctx), "buffers");
+}
+
+void FULUEJSBridge::ExposeBuffer(JSContextRef Ctx, const FString& Name, FPublishedBuffer& Published)
+{
+	const FULUEJSBufferRef& Buffer = Published.Buffer;
+
+	// The array owns a reference to the buffer; the deallocator runs when the array is collected
+	// (or right away if creation throws).
+	JSValueRef Exception = nullptr;
+	const JSObjectRef Array = JSObjectMakeTypedArrayWithBytesNoCopy(Ctx, ToJSTypedArrayType(Buffer->GetType()),
+		Buffer->GetData(), static_cast<size_t>(Buffer->GetNumBytes()), &ReleaseBufferReference, new FULUEJSBufferPtr(Buffer), &Exception);
+	if (!Array)
+	{
+		UE_LOG(LogUltralightUE, Warning, TEXT("Could not expose buffer '%s' (%lld bytes) to JavaScript"), *Name, Buffer->GetNumBytes());
+		return;
+	}
+
+	const uint32 Version = Buffer->GetVersion();
+	const JSObjectRef Holder = JSObjectMake(Ctx, nullptr, nullptr);
+	JSObjectSetProperty(Ctx, Holder, FJSString("data"), Array, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete, nullptr);
+	JSObjectSetProperty(Ctx, Holder, GetVersionKey(), JSValueMakeNumber(Ctx, Version), kJSPropertyAttributeNone, nullptr);
+	JSObjectSetProperty(Ctx, GetBuffersObject(Ctx), FJSString(Name), Holder, kJSPropertyAttributeNone, nullptr);
+
+	JSValueProtect(Ctx, Holder);
+	Published.Holder = Holder;
+	Published.PublishedVersion = Version;
+}
+
+void FULUEJSBridge::ReleaseHolder(JSContextRef Ctx, FPublishedBuffer& Published)
+{
+	if (Published.Holder)
+	{
+		JSValueUnprotect(Ctx, Published.Holder);
+		Published.Holder = nullptr;
+	}
+}
+
+void FULUEJSBridge::ExposeFunction(JSContextRef Ctx, const FNativeFunctionRef& Native)
+{
+	// The object's private data is a reference of its own, dropped when the page finalizes the function.
+	const JSObjectRef Function = JSObjectMake(Ctx, GetNativeFunctionClass(), new FNativeFunctionRef(Native));
+	JSObjectSetProperty(Ctx, GetUeObject(Ctx), FJSString(Native->Name), Function, kJSPropertyAttributeNone, nullptr);
+}
+
+JSClassRef FULUEJSBridge::GetNativeFunctionClass()
+{
+	// JSObjectMakeFunctionWithCallback can't carry a context pointer, so native functions are instances of a
+	// callable class instead. Created once and shared by every view.
+	static const JSClassRef Class = []
+	{
+		JSClassDefinition Definition = kJSClassDefinitionEmpty;
+		Definition.className = "UEFunction";
+		Definition.callAsFunction = &FULUEJSBridge::CallNativeFunction;
+		Definition.finalize = &FULUEJSBridge::FinalizeNativeFunction;
+		return JSClassCreate(&Definition);
+	}();
+	return Class;
+}
+
+JSValueRef FULUEJSBridge::CallNativeFunction(JSContextRef Ctx, JSObjectRef Function, JSObjectRef /*This*/, size_t ArgumentCount, const JSValueRef Arguments[], JSValueRef* /*Exception*/)
+{
+	const FNativeFunctionRef* Native = static_cast<const FNativeFunctionRef*>(JSObjectGetPrivate(Function));
+	if (!Native || (*Native)->bUnbound || !(*Native)->Callback)
+	{
+		return JSValueMakeUndefined(Ctx);
+	}
+
+	TArray<FULUEJSValue, TInlineAllocator<8>> Args;
+	Args.Reserve(static_cast<int32>(ArgumentCount));
+	for (size_t Index = 0; Index < ArgumentCount; ++Index)
+	{
+		Args.Add(FromJSValue(Ctx, Arguments[Index]));
+	}
+
+	INC_DWORD_STAT(STAT_UltralightNativeCallbacks);
+	return ToJSValue(Ctx, (*Native)->Callback(Args));
+}
+
+void FULUEJSBridge::FinalizeNativeFunction(JSObjectRef Function)
+{
+	delete static_cast<FNativeFunctionRef*>(JSObjectGetPrivate(Function));
+}
@@ -0,0 +1,108 @@
+/*
+ * Native bridge between UE and a view's JavaScript context (JavaScriptCore C API).
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Scripting/ULUEJSBuffer.h"
+#include "Scripting/ULUEJSValue.h"
+#include "ULUEUltralightIncludes.h"
+
+/**
+ * Per-view JavaScript state owned by FULUEView. Everything the bridge puts into the page lives under
+ * `window.ue` and is rebuilt whenever the page gets a new window object (navigation, reload, thaw).
+ * Game thread only.
+ */
+class FULUEJSBridge : public ultralight::LoadListener
+{
+public:
+	virtual ~FULUEJSBridge() override;
+
+	/// @brief Starts listening to InView; called for every native view the owning FULUEView creates.
+	void Attach(ultralight::View* InView);
+	/// @brief Stops listening and releases everything protected in the page; call while the native view is still
+	/// alive. Published state is kept for the next Attach;
+	/// queued calls are dropped with the page they were meant for.
+	void Detach();
+
+	/// @brief Exposes Buffer as `window.ue.buffers[Name] = { data: <typed array>, version }` without copying.
+	/// The typed array keeps Buffer alive until the page's garbage collector drops it.
+	void PublishBuffer(const FString& Name, const FULUEJSBufferRef& Buffer);
+	void UnpublishBuffer(const FString& Name);
+
+	/// @brief Makes Callback callable from the page as `window.ue[Name](...)`, now and after every navigation.
+	/// Rebinding a name replaces the function; "buffers" is reserved.
+	void BindFunction(const FString& Name, FULUEJSCallback&& Callback);
+	void UnbindFunction(const FString& Name);
+
+	/// @brief Queues `Function(Args...)` for the next Flush. Function is a global name or a dotted path ("hud.setHealth").
+	/// It is resolved once per page and then called through a cached handle, so reassigning it later has no effect.
+	void EnqueueCall(const FString& Function, TArray<FULUEJSValue>&& Args);
+
+	/// @brief Start of the Ultralight tick: pushes state changed since the last tick into the page, then runs
+	/// queued calls in order, all under one context lock. Calls wait while the page is still loading.
+	void Flush();
+
+	//~ Begin ultralight::LoadListener Interface
+	virtual void OnWindowObjectReady(ultralight::View* caller, uint64_t frame_id, bool is_main_frame, const ultralight::String& url) override;
+	//~ End ultralight::LoadListener Interface
+
+private:
+	struct FPublishedBuffer
+	{
+		FULUEJSBufferRef Buffer;
+		/// The `{ data, version }` object, protected from GC while we may still write its version.
+		JSObjectRef Holder = nullptr;
+		uint32 PublishedVersion = 0;
+	};
+
+	struct FQueuedCall
+	{
+		FString Function;
+		TArray<FULUEJSValue> Args;
+	};
+
+	/// Resolved page function and the object it was found on, both protected until the page goes away.
+	struct FCachedFunction
+	{
+		JSObjectRef Function = nullptr;
+		JSObjectRef This = nullptr;
+	};
+
+	/// Shared with the JS function objects, which can outlive the bridge until the page's GC finalizes them.
+	struct FNativeFunction
+	{
+		FString Name;
+		FULUEJSCallback Callback;
+		/// Set when unbound or rebound; function objects the page kept become no-ops.
+		bool bUnbound = false;
+	};
+	using FNativeFunctionRef = TSharedRef<FNativeFunction, ESPMode::ThreadSafe>;
+
+	void DispatchCalls(JSContextRef Ctx);
+	/// Cached handle for Path, resolving it on first use. Unresolved paths aren't cached; the page may define them later.
+	const FCachedFunction* FindFunction(JSContextRef Ctx, const FString& Path);
+	/// Unprotects cached handles.
+	void ReleaseFunctionCache(JSContextRef Ctx);
+	/// Walks Path's segments from the global object; OutThis receives the object the function was found on.
+	static JSObjectRef ResolveFunction(JSContextRef Ctx, FStringView Path, JSObjectRef& OutThis);
+
+	/// `window.ue.buffers`, created on demand.
+	JSObjectRef GetBuffersObject(JSContextRef Ctx);
+	void ExposeBuffer(JSContextRef Ctx, const FString& Name, FPublishedBuffer& Published);
+	void ReleaseHolder(JSContextRef Ctx, FPublishedBuffer& Published);
+	/// `window.ue`, created on demand.
+	static JSObjectRef GetUeObject(JSContextRef Ctx);
+	static void ExposeFunction(JSContextRef Ctx, const FNativeFunctionRef& Native);
+
+	static JSClassRef GetNativeFunctionClass();
+	static JSValueRef CallNativeFunction(JSContextRef Ctx, JSObjectRef Function, JSObjectRef This, size_t ArgumentCount, const JSValueRef Arguments[], JSValueRef* Exception);
+	static void FinalizeNativeFunction(JSObjectRef Function);
+
+	ultralight::View* View = nullptr;
+	TMap<FString, FPublishedBuffer> Buffers;
+	TArray<FQueuedCall> PendingCalls;
+	TMap<FString, FCachedFunction> FunctionCache;
+	TMap<FString, FNativeFunctionRef> NativeFunctions;
+};
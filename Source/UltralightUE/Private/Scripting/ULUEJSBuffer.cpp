@@ -0,0 +1,47 @@
+/*
+ * UE-owned memory shared with a page as a JavaScript typed array.
+ */
+
+#include "Scripting/ULUEJSBuffer.h"
+
+namespace
+{
+	/// Typed arrays need element alignment; 16 also keeps the memory friendly to vectorized writers.
+	constexpr uint32 BufferAlignment = 16;
+}
+
+FULUEJSBufferRef FULUEJSBuffer::Create(EULUETypedArrayType InType, int32 InNumElements)
+{
+	return MakeShareable(new FULUEJSBuffer(InType, InNumElements));
+}
+
+FULUEJSBuffer::FULUEJSBuffer(EULUETypedArrayType InType, int32 InNumElements)
+	: NumElements(FMath::Max(InNumElements, 0))
+	, Type(InType)
+{
+	// Never null, so an empty buffer still becomes a valid zero-length array.
+	Data = static_cast<uint8*>(FMemory::MallocZeroed(FMath::Max<SIZE_T>(GetNumBytes(), 1), BufferAlignment));
+}
+
+FULUEJSBuffer::~FULUEJSBuffer()
+{
+	FMemory::Free(Data);
+}
+
+int32 FULUEJSBuffer::GetElementSize(EULUETypedArrayType InType)
+{
+	switch (InType)
+	{
+	case EULUETypedArrayType::Int16:
+	case EULUETypedArrayType::Uint16:
+		return 2;
+	case EULUETypedArrayType::Int32:
+	case EULUETypedArrayType::Uint32:
+	case EULUETypedArrayType::Float32:
+		return 4;
+	case EULUETypedArrayType::Float64:
+		return 8;
+	default:
+		return 1;
+	}
+}
@@ -0,0 +1,35 @@
+/*
+ * Plain values passed between UE and page script.
+ */
+
+#include "Scripting/ULUEJSValue.h"
+
+FString FULUEJSValue::ToString() const
+{
+	switch (Type)
+	{
+	case EULUEJSValueType::Null:
+		return TEXT("null");
+	case EULUEJSValueType::Boolean:
+		return Number != 0.0 ? TEXT("true") : TEXT("false");
+	case EULUEJSValueType::Number:
+		if (FMath::IsNaN(Number))
+		{
+			return TEXT("NaN");
+		}
+		if (!FMath::IsFinite(Number))
+		{
+			return Number > 0.0 ? TEXT("Infinity") : TEXT("-Infinity");
+		}
+		// Integral values print without a fraction, as in JavaScript.
+		if (FMath::Abs(Number) < 9007199254740992.0 && FMath::FloorToDouble(Number) == Number)
+		{
+			return FString::Printf(TEXT("%lld"), static_cast<int64>(Number));
+		}
+		return FString::SanitizeFloat(Number);
+	case EULUEJSValueType::String:
+		return String;
+	default:
+		return TEXT("undefined");
+	}
+}
@@ -0,0 +1,120 @@
+/*
+ * Stat definitions and memory counters for UltralightUE.
+ */
+
+#include "ULUEStats.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_UltralightTick);
+DEFINE_STAT(STAT_UltralightUpdate);
+DEFINE_STAT(STAT_UltralightRender);
+DEFINE_STAT(STAT_UltralightPaint);
+DEFINE_STAT(STAT_UltralightCopy);
+DEFINE_STAT(STAT_UltralightUpload);
+DEFINE_STAT(STAT_UltralightOpenFile);
+DEFINE_STAT(STAT_UltralightDecompress);
+DEFINE_STAT(STAT_UltralightScriptFlush);
+
+DEFINE_STAT(STAT_UltralightLiveViews);
+DEFINE_STAT(STAT_UltralightFrozenViews);
+DEFINE_STAT(STAT_UltralightViewUploadBytes);
+DEFINE_STAT(STAT_UltralightFileCacheHits);
+DEFINE_STAT(STAT_UltralightFileCacheMisses);
+DEFINE_STAT(STAT_UltralightFontFallbackHits);
+DEFINE_STAT(STAT_UltralightFontFallbackMisses);
+DEFINE_STAT(STAT_UltralightJSCalls);
+DEFINE_STAT(STAT_UltralightNativeCallbacks);
+
+DEFINE_STAT(STAT_UltralightRenderTargetMemory);
+DEFINE_STAT(STAT_UltralightStagingMemory);
+DEFINE_STAT(STAT_UltralightFileBufferMemory);
+DEFINE_STAT(STAT_UltralightMappedFileMemory);
+DEFINE_STAT(STAT_UltralightHeapMemory);
+DEFINE_STAT(STAT_UltralightHeapPeakMemory);
+DEFINE_STAT(STAT_UltralightAlignedMemory);
+DEFINE_STAT(STAT_UltralightAlignedPeakMemory);
+DEFINE_STAT(STAT_UltralightLiveAllocations);
+
+CSV_DEFINE_CATEGORY(Ultralight, true);
+
+namespace ultralightue
+{
+	namespace
+	{
+		// Stats can't be read back, so keep our own totals for CSV and the query helpers.
+		std::atomic<int64> GTrackedMemory[static_cast<int32>(EULUEMemoryCounter::Num)];
+	}
+
+	void TrackMemory(EULUEMemoryCounter Counter, int64 DeltaBytes)
+	{
+		if (DeltaBytes == 0)
+		{
+			return;
+		}
+
+		GTrackedMemory[static_cast<int32>(Counter)].fetch_add(DeltaBytes, std::memory_order_relaxed);
+
+		switch (Counter)
+		{
+		case EULUEMemoryCounter::RenderTarget:
+			if (DeltaBytes > 0)
+			{
+				INC_MEMORY_STAT_BY(STAT_UltralightRenderTargetMemory, DeltaBytes);
+			}
+			else
+			{
+				DEC_MEMORY_STAT_BY(STAT_UltralightRenderTargetMemory, -DeltaBytes);
+			}
+			break;
+		case EULUEMemoryCounter::Staging:
+			if (DeltaBytes > 0)
+			{
+				INC_MEMORY_STAT_BY(STAT_UltralightStagingMemory, DeltaBytes);
+			}
+			else
+			{
+				DEC_MEMORY_STAT_BY(STAT_UltralightStagingMemory, -DeltaBytes);
+			}
+			break;
+		case EULUEMemoryCounter::FileBuffers:
+			if (DeltaBytes > 0)
+			{
+				INC_MEMORY_STAT_BY(STAT_UltralightFileBufferMemory, DeltaBytes);
+			}
+			else
+			{
+				DEC_MEMORY_STAT_BY(STAT_UltralightFileBufferMemory, -DeltaBytes);
+			}
+			break;
+		case EULUEMemoryCounter::MappedFiles:
+			if (DeltaBytes > 0)
+			{
+				INC_MEMORY_STAT_BY(STAT_UltralightMappedFileMemory, DeltaBytes);
+			}
+			else
+			{
+				DEC_MEMORY_STAT_BY(STAT_UltralightMappedFileMemory, -DeltaBytes);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	int64 GetTrackedMemory(EULUEMemoryCounter Counter)
+	{
+		return GTrackedMemory[static_cast<int32>(Counter)].load(std::memory_order_relaxed);
+	}
+
+	void RecordCsvCounters(int32 LiveViews)
+	{
+#if CSV_PROFILER
+		constexpr double BytesToMB = 1.0 / (1024.0 * 1024.0);
+		CSV_CUSTOM_STAT(Ultralight, LiveViews, LiveViews, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Ultralight, RenderTargetMB, static_cast<float>(GetTrackedMemory(EULUEMemoryCounter::RenderTarget) * BytesToMB), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Ultralight, StagingMB, static_cast<float>(GetTrackedMemory(EULUEMemoryCounter::Staging) * BytesToMB), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Ultralight, FileBufferMB, static_cast<float>(GetTrackedMemory(EULUEMemoryCounter::FileBuffers) * BytesToMB), ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Ultralight, MappedFileMB, static_cast<float>(GetTrackedMemory(EULUEMemoryCounter::MappedFiles) * BytesToMB), ECsvCustomStatOp::Set);
+#endif
+	}
+}
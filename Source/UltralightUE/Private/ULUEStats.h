@@ -0,0 +1,122 @@
+/*
+ * Stats group and per-view timing helpers for UltralightUE.
+ * Everything here shows up under `stat Ultralight` and as CPU scopes in Unreal Insights.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("Ultralight"), STATGROUP_Ultralight, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick"), STAT_UltralightTick, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Renderer Update"), STAT_UltralightUpdate, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Renderer Render"), STAT_UltralightRender, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Paint If Needed"), STAT_UltralightPaint, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bitmap Copy"), STAT_UltralightCopy, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Texture Upload (RT)"), STAT_UltralightUpload, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FileSystem OpenFile"), STAT_UltralightOpenFile, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FileSystem Decompress"), STAT_UltralightDecompress, STATGROUP_Ultralight, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Script Flush"), STAT_UltralightScriptFlush, STATGROUP_Ultralight, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Views"), STAT_UltralightLiveViews, STATGROUP_Ultralight, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Frozen Views"), STAT_UltralightFrozenViews, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("View Upload Bytes"), STAT_UltralightViewUploadBytes, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("File Cache Hits"), STAT_UltralightFileCacheHits, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("File Cache Misses"), STAT_UltralightFileCacheMisses, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Font Fallback Hits"), STAT_UltralightFontFallbackHits, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Font Fallback Misses"), STAT_UltralightFontFallbackMisses, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("JS Calls"), STAT_UltralightJSCalls, STATGROUP_Ultralight, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Native Callbacks"), STAT_UltralightNativeCallbacks, STATGROUP_Ultralight, );
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Render Target Memory"), STAT_UltralightRenderTargetMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Staging Memory"), STAT_UltralightStagingMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("File Buffer Memory"), STAT_UltralightFileBufferMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Mapped File Memory"), STAT_UltralightMappedFileMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Library Heap"), STAT_UltralightHeapMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Library Heap Peak"), STAT_UltralightHeapPeakMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Library Aligned Heap"), STAT_UltralightAlignedMemory, STATGROUP_Ultralight, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Library Aligned Heap Peak"), STAT_UltralightAlignedPeakMemory, STATGROUP_Ultralight, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Library Live Allocations"), STAT_UltralightLiveAllocations, STATGROUP_Ultralight, );
+
+CSV_DECLARE_CATEGORY_EXTERN(Ultralight);
+
+/// Cycle stat plus a CSV timing under the same name, so `stat Ultralight` and CSV captures agree.
+#define ULUE_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Ultralight##Name); \
+	CSV_SCOPED_TIMING_STAT(Ultralight, Name)
+
+namespace ultralightue
+{
+	/// Memory tracked by the plugin; each maps to a STAT_Ultralight*Memory stat and a CSV column.
+	enum class EULUEMemoryCounter : uint8
+	{
+		RenderTarget,
+		Staging,
+		FileBuffers,
+		MappedFiles, /// Address space of memory-mapped files; resident only as pages are touched.
+		Num
+	};
+
+	/// @brief Adjusts a tracked memory counter. Safe to call from any thread.
+	void TrackMemory(EULUEMemoryCounter Counter, int64 DeltaBytes);
+
+	/// @brief Current value of a tracked memory counter, in bytes.
+	int64 GetTrackedMemory(EULUEMemoryCounter Counter);
+
+	/// @brief Writes the per-frame counters (live views, tracked memory) to the CSV profiler.
+	void RecordCsvCounters(int32 LiveViews);
+
+	/// Per-view stages that get their own dynamic stat and Insights scope.
+	enum class EULUEViewStage : uint8
+	{
+		Render,
+		Copy,
+		Num
+	};
+
+	/**
+	 * Scoped timer for one stage of one view.
+	 * Feeds the view's dynamic cycle stat, emits a named Insights CPU scope and writes the elapsed time
+	 * in milliseconds to OutMilliseconds on destruction.
+	 */
+	class FULUEViewStageScope
+	{
+	public:
+		FULUEViewStageScope(TStatId InStatId, const FString& EventName, float& OutMilliseconds)
+			: CycleCounter(InStatId)
+			, Result(OutMilliseconds)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+#if CPUPROFILERTRACE_ENABLED
+			bTraceEvent = UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+			if (bTraceEvent)
+			{
+				FCpuProfilerTrace::OutputBeginDynamicEvent(*EventName);
+			}
+#endif
+		}
+
+		~FULUEViewStageScope()
+		{
+#if CPUPROFILERTRACE_ENABLED
+			if (bTraceEvent)
+			{
+				FCpuProfilerTrace::OutputEndEvent();
+			}
+#endif
+			Result = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		}
+
+	private:
+		FScopeCycleCounter CycleCounter;
+		float& Result;
+		uint64 StartCycles;
+#if CPUPROFILERTRACE_ENABLED
+		bool bTraceEvent = false;
+#endif
+	};
+}
@@ -1,5 +1,5 @@
 /*
- * Ultralight runtime subsystem responsible for ticking the renderer and creating views.
+ * Ultralight runtime subsystem: holds a reference on the shared renderer and creates views in its own session.
  */
 
 #include "ULUESubsystem.h"
@@ -7,7 +7,7 @@
 #include "Rendering/ULUEView.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
-#include "Containers/Ticker.h"
+#include "Engine/GameInstance.h"
 
 using namespace ultralightue;
 
@@ -29,29 +29,43 @@ void UUltralightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UUltralightSubsystem::Deinitialize()
 {
-	if (TickHandle.IsValid())
-	{
-		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
-		TickHandle.Reset();
-	}
-
 	if (Renderer.IsValid())
 	{
-		Renderer->Shutdown();
-		Renderer.Reset();
+		// Other game instances keep using the renderer and named sessions; only this instance's views go away.
+		for (const TWeakObjectPtr<UUltralightView>& View : CreatedViews)
+		{
+			if (View.IsValid())
+			{
+				View->ReleaseNative();
+			}
+		}
+		CreatedViews.Empty();
+		Renderer->DestroyViewsInSession(Session);
+		Session = nullptr;
+		FULUERenderer::Release(Renderer);
 	}
 
 	Super::Deinitialize();
 }
 
-UUltralightView* UUltralightSubsystem::CreateView(int32 Width, int32 Height, bool bTransparent, const FString& InitialURL, UTextureRenderTarget2D* ExistingTarget)
+UUltralightView* UUltralightSubsystem::CreateView(int32 Width, int32 Height, bool bTransparent, const FString& InitialURL, UTextureRenderTarget2D* ExistingTarget, bool bAccelerated, const FString& SessionName)
 {
 	if (!EnsureRenderer())
 	{
 		return nullptr;
 	}
 
-	TSharedPtr<FULUEView> NativeView = Renderer->CreateView(FIntPoint(Width, Height), bTransparent, InitialURL, this, ExistingTarget);
+	ultralight::RefPtr<ultralight::Session> ViewSession = Session;
+	if (!SessionName.IsEmpty())
+	{
+		ViewSession = Renderer->FindOrCreateSession(SessionName, false);
+		if (!ViewSession)
+		{
+			return nullptr;
+		}
+	}
+
+	TSharedPtr<FULUEView> NativeView = Renderer->CreateView(FIntPoint(Width, Height), bTransparent, InitialURL, this, ExistingTarget, bAccelerated, ViewSession);
 	if (!NativeView.IsValid())
 	{
 		return nullptr;
@@ -59,6 +73,8 @@ UUltralightView* UUltralightSubsystem::CreateView(int32 Width, int32 Height, boo
 
 	UUltralightView* Wrapper = NewObject<UUltralightView>(this);
 	Wrapper->InitializeNative(Renderer.ToSharedRef(), NativeView);
+	CreatedViews.RemoveAll([](const TWeakObjectPtr<UUltralightView>& Candidate) { return !Candidate.IsValid(); });
+	CreatedViews.Add(Wrapper);
 	return Wrapper;
 }
 
@@ -72,39 +88,54 @@ void UUltralightSubsystem::DestroyView(UUltralightView* View)
 	View->ReleaseNative();
 }
 
-bool UUltralightSubsystem::EnsureRenderer()
+bool UUltralightSubsystem::CreateSession(const FString& Name, bool bPersistent)
 {
-	if (!Renderer.IsValid())
-	{
-		Renderer = MakeShared<FULUERenderer>();
-	}
+	return EnsureRenderer() && Renderer->FindOrCreateSession(Name, bPersistent);
+}
 
-	if (Renderer->IsInitialized())
+bool UUltralightSubsystem::HasSession(const FString& Name) const
+{
+	return Renderer.IsValid() && Renderer->FindSession(Name);
+}
+
+FString UUltralightSubsystem::GetSessionDiskPath(const FString& Name) const
+{
+	const ultralight::RefPtr<ultralight::Session> Found = Renderer.IsValid() ? Renderer->FindSession(Name) : nullptr;
+	return Found && Found->is_persistent() ? FString(UTF8_TO_TCHAR(Found->disk_path().utf8().data())) : FString();
+}
+
+TArray<FULUEViewTimings> UUltralightSubsystem::GetViewTimings() const
+{
+	// Views can live in named sessions too, so go by the views this subsystem created rather than its default session.
+	TArray<FULUEViewTimings> Result;
+	Result.Reserve(CreatedViews.Num());
+	for (const TWeakObjectPtr<UUltralightView>& WeakView : CreatedViews)
 	{
-		if (!TickHandle.IsValid())
+		if (const UUltralightView* View = WeakView.Get())
 		{
-			TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUltralightSubsystem::Tick));
+			Result.Add(View->GetTimings());
 		}
-		return true;
 	}
+	return Result;
+}
 
-	const bool bInitialized = Renderer->Initialize(ResourceRoot, FSAccess::FSA_Native, nullptr);
-	if (bInitialized && !TickHandle.IsValid())
-	{
-		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUltralightSubsystem::Tick));
-	}
-	if (bInitialized)
+bool UUltralightSubsystem::EnsureRenderer()
+{
+	if (!Renderer.IsValid())
 	{
+		Renderer = FULUERenderer::Acquire(ResourceRoot, ULUEFileSystem::GetDefaultFSAccess());
+		if (!Renderer.IsValid())
+		{
+			return false;
+		}
 		ResourceRoot = Renderer->GetResourceRoot();
 	}
-	return bInitialized;
-}
 
-bool UUltralightSubsystem::Tick(float DeltaSeconds)
-{
-	if (Renderer.IsValid())
+	if (!Session)
 	{
-		Renderer->Tick(DeltaSeconds);
+		const UGameInstance* GameInstance = GetGameInstance();
+		const FString SessionName = FString::Printf(TEXT("GameInstance_%u"), GameInstance ? GameInstance->GetUniqueID() : 0u);
+		Session = Renderer->CreateSession(false, SessionName);
 	}
 	return true;
 }
@@ -0,0 +1,66 @@
+/*
+ * Unreal Insights trace channel and events for UltralightUE.
+ */
+
+#include "ULUETrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(UltralightChannel)
+
+UE_TRACE_EVENT_BEGIN(Ultralight, ViewInfo)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ViewId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Url)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, DebugName)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Ultralight, LogMessage)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Level)
+	UE_TRACE_EVENT_FIELD(uint32, ViewId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Url)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Message)
+UE_TRACE_EVENT_END()
+
+namespace ultralightue
+{
+	namespace
+	{
+		thread_local uint32 GCurrentViewId = 0;
+		thread_local const FString* GCurrentViewUrl = nullptr;
+	}
+
+	FULUETraceViewContext::FULUETraceViewContext(uint32 ViewId, const FString& Url)
+		: PreviousViewId(GCurrentViewId)
+		, PreviousUrl(GCurrentViewUrl)
+	{
+		GCurrentViewId = ViewId;
+		GCurrentViewUrl = &Url;
+	}
+
+	FULUETraceViewContext::~FULUETraceViewContext()
+	{
+		GCurrentViewId = PreviousViewId;
+		GCurrentViewUrl = PreviousUrl;
+	}
+
+	void TraceViewInfo(uint32 ViewId, const FString& Url, const FString& DebugName)
+	{
+		UE_TRACE_LOG(Ultralight, ViewInfo, UltralightChannel)
+			<< ViewInfo.Cycle(FPlatformTime::Cycles64())
+			<< ViewInfo.ViewId(ViewId)
+			<< ViewInfo.Url(*Url, Url.Len())
+			<< ViewInfo.DebugName(*DebugName, DebugName.Len());
+	}
+
+	void TraceLogMessage(uint8 Level, const FString& Message)
+	{
+		const FString EmptyUrl;
+		const FString& Url = GCurrentViewUrl ? *GCurrentViewUrl : EmptyUrl;
+		UE_TRACE_LOG(Ultralight, LogMessage, UltralightChannel)
+			<< LogMessage.Cycle(FPlatformTime::Cycles64())
+			<< LogMessage.Level(Level)
+			<< LogMessage.ViewId(GCurrentViewId)
+			<< LogMessage.Url(*Url, Url.Len())
+			<< LogMessage.Message(*Message, Message.Len());
+	}
+}
@@ -0,0 +1,85 @@
+/*
+ * Unreal Insights trace channel for UltralightUE.
+ * Enable with `-trace=default,Ultralight` (or `Trace.Enable Ultralight` at runtime).
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+UE_TRACE_CHANNEL_EXTERN(UltralightChannel)
+
+namespace ultralightue
+{
+	/// @brief True when Ultralight events should be emitted (channel and CPU profiler both enabled).
+	inline bool IsUltralightTraceEnabled()
+	{
+#if CPUPROFILERTRACE_ENABLED
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(UltralightChannel | CpuChannel);
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Scoped timing event on UltralightChannel with a dynamic name.
+	 * The name builder only runs while tracing, so call sites can format view IDs, URLs or paths freely.
+	 */
+	class FULUETraceScope
+	{
+	public:
+		template <typename NameBuilderType>
+		explicit FULUETraceScope(NameBuilderType&& BuildName)
+		{
+#if CPUPROFILERTRACE_ENABLED
+			bActive = IsUltralightTraceEnabled();
+			if (bActive)
+			{
+				const FString Name = BuildName();
+				FCpuProfilerTrace::OutputBeginDynamicEvent(*Name);
+			}
+#endif
+		}
+
+		~FULUETraceScope()
+		{
+#if CPUPROFILERTRACE_ENABLED
+			if (bActive)
+			{
+				FCpuProfilerTrace::OutputEndEvent();
+			}
+#endif
+		}
+
+	private:
+#if CPUPROFILERTRACE_ENABLED
+		bool bActive = false;
+#endif
+	};
+
+	/**
+	 * Marks the view being rendered/painted on this thread, so logger messages emitted meanwhile
+	 * are attributed to it in the trace.
+	 */
+	class FULUETraceViewContext
+	{
+	public:
+		FULUETraceViewContext(uint32 ViewId, const FString& Url);
+		~FULUETraceViewContext();
+
+	private:
+		uint32 PreviousViewId;
+		const FString* PreviousUrl;
+	};
+
+	/// @brief Emits Ultralight.ViewInfo, mapping a view ID to its current URL and debug name.
+	void TraceViewInfo(uint32 ViewId, const FString& Url, const FString& DebugName);
+
+	/// @brief Emits Ultralight.LogMessage, tagged with the view in the current FULUETraceViewContext (0 if none).
+	void TraceLogMessage(uint8 Level, const FString& Message);
+}
+
+#define ULUE_TRACE_SCOPE(NameExpr) \
+	::ultralightue::FULUETraceScope PREPROCESSOR_JOIN(ULUETraceScope, __LINE__)([&]() -> FString { return NameExpr; })
@@ -29,6 +29,7 @@
 #include <Ultralight/MouseEvent.h>
 #include <Ultralight/KeyEvent.h>
 #include <Ultralight/ScrollEvent.h>
+#include <Ultralight/JavaScript.h>
 
 // Pop UE macros back
 #pragma pop_macro("PI")
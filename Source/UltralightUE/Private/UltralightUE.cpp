@@ -22,6 +22,7 @@
  */
 #include "UltralightUE.h"
 #include "ULUELogInterface.h"
+#include "Memory/ULUEAllocator.h"
 #include "CoreMinimal.h"
 #include "Misc/Paths.h"
 #include "Misc/MessageDialog.h"
@@ -118,8 +119,11 @@ void FUltralightUEModule::StartupModule()
 	}
 #endif // PLATFORM_WINDOWS
 	/// Assign handles to Library(s) path(s).
-	WebCoreHandle = !WebCoreLibraryPath.IsEmpty() ? FPlatformProcess::GetDllHandle(*WebCoreLibraryPath) : nullptr;
+	/// UltralightCore goes first: it owns ulAllocator, which has to be redirected before WebCore or
+	/// Ultralight run any code that allocates.
 	UltralightCoreHandle = !UltralightCoreLibraryPath.IsEmpty() ? FPlatformProcess::GetDllHandle(*UltralightCoreLibraryPath) : nullptr;
+	ultralightue::InstallUltralightAllocator(UltralightCoreHandle);
+	WebCoreHandle = !WebCoreLibraryPath.IsEmpty() ? FPlatformProcess::GetDllHandle(*WebCoreLibraryPath) : nullptr;
 	UltralightHandle = !UltralightLibraryPath.IsEmpty() ? FPlatformProcess::GetDllHandle(*UltralightLibraryPath) : nullptr;
 	
 #if PLATFORM_MAC || PLATFORM_LINUX
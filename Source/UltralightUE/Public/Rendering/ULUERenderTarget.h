@@ -25,6 +25,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include <atomic>
 #include <Ultralight/RenderTarget.h> // Assuming this is the correct include from Ultralight SDK
 #include "ULUERenderTarget.generated.h" // For UCLASS macro if this becomes a UObject
 
@@ -66,6 +67,18 @@ public:
 	// being a delegate for Ultralight's rendering process or implementing ultralight::GPUDriver.
 	void OnUltralightDraw(ultralight::Bitmap* Bitmap);
 
+	/// @brief Bytes queued for upload by the last OnUltralightDraw.
+	uint64 GetLastUploadBytes() const { return LastUploadBytes; }
+
+	/// @brief Render-thread time of the last completed upload, in milliseconds.
+	float GetLastUploadMilliseconds() const;
+
+	/// @brief Re-reports render target and staging memory after a resize.
+	void RefreshMemoryStats();
+
+	/// @brief Frees the CPU staging buffer; it is reallocated by the next OnUltralightDraw.
+	void ReleaseStagingMemory();
+
 private:
 	UPROPERTY(Transient) // Transient if this UObject is just a wrapper and the RT is managed elsewhere
 	TObjectPtr<UTextureRenderTarget2D> RenderTarget;
@@ -78,4 +91,10 @@ private:
 	TArray<uint8> PixelData;
 	uint32 Width;
 	uint32 Height;
+
+	uint64 LastUploadBytes = 0;
+	int64 TrackedRenderTargetBytes = 0;
+	int64 TrackedStagingBytes = 0;
+	// Written by the render-thread upload, read by per-view stats on the game thread.
+	TSharedPtr<std::atomic<uint64>, ESPMode::ThreadSafe> LastUploadCycles;
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "CoreMinimal.h"
 #include "Rendering/ULUERenderTarget.h"
 #include "InputCoreTypes.h"
+#include "Scripting/ULUEJSBuffer.h"
+#include "Scripting/ULUEJSValue.h"
 #include "ULUEUltralightIncludes.h"
 #include "ULUEView.generated.h"
 
@@ -22,6 +24,44 @@ enum class EULUEMouseButton : uint8
 	Right UMETA(DisplayName = "Right")
 };
 
+/**
+ * Last-frame cost breakdown for one view. Times are in milliseconds.
+ * CPU views fill Copy/Upload; accelerated views fill GPU instead.
+ */
+USTRUCT(BlueprintType)
+struct ULTRALIGHTUE_API FULUEViewTimings
+{
+	GENERATED_BODY()
+
+	/** Debug name if one was set, otherwise the last loaded URL. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	FString Name;
+
+	/** This view's share of Renderer::Update (split evenly across live views). */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	float UpdateShareMs = 0.0f;
+
+	/** Time spent rendering this view (CPU raster, or command list generation when accelerated). */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	float RenderMs = 0.0f;
+
+	/** Game-thread bitmap copy in OnUltralightDraw. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	float CopyMs = 0.0f;
+
+	/** Render-thread texture upload of the copied bitmap. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	float UploadMs = 0.0f;
+
+	/** Bytes uploaded to the render target last paint. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	int64 UploadBytes = 0;
+
+	/** GPU time of this view's render passes, from RHI timestamps (a few frames latent). */
+	UPROPERTY(BlueprintReadOnly, Category = "Ultralight|Stats")
+	float GPUMs = 0.0f;
+};
+
 /**
  * UObject wrapper for an Ultralight View.
  * Holds onto the render target and provides simple input forwarding helpers.
@@ -50,6 +90,77 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Ultralight", meta = (DisplayName = "Get Render Target"))
 	UTextureRenderTarget2D* GetRenderTarget() const { return RenderTarget; }
 
+	/**
+	 * Releases the native view (DOM, JS heap, surface) and keeps showing its last frame.
+	 * JS state is lost: Thaw() reloads the last URL/HTML and restores scroll and focus.
+	 * Clicks, scrolling, key input, loads, resizes and focusing thaw the view automatically.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultralight|Memory", meta = (DisplayName = "Freeze View"))
+	bool Freeze();
+
+	UFUNCTION(BlueprintCallable, Category = "Ultralight|Memory", meta = (DisplayName = "Thaw View"))
+	bool Thaw();
+
+	UFUNCTION(BlueprintPure, Category = "Ultralight|Memory", meta = (DisplayName = "Is View Frozen"))
+	bool IsFrozen() const;
+
+	/**
+	 * Lets the renderer freeze this view when it is least recently used and over
+	 * Ultralight.MaxActiveViews / Ultralight.MemoryBudgetMB, or on a memory warning.
+	 * Meant for pages that are static after their first paint; off by default.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultralight|Memory", meta = (DisplayName = "Set Auto Freeze"))
+	void SetAutoFreeze(bool bAutoFreeze);
+
+	/** Name used for this view in stats and Insights; defaults to the loaded URL. */
+	UFUNCTION(BlueprintCallable, Category = "Ultralight|Stats", meta = (DisplayName = "Set Debug Name"))
+	void SetDebugName(const FString& DebugName);
+
+	UFUNCTION(BlueprintPure, Category = "Ultralight|Stats", meta = (DisplayName = "Get View Timings"))
+	FULUEViewTimings GetTimings() const;
+
+	/** Name of the session (cookies, storage, cache) this view was created in. */
+	UFUNCTION(BlueprintPure, Category = "Ultralight|Session", meta = (DisplayName = "Get Session Name"))
+	FString GetSessionName() const;
+
+	/**
+	 * Shares Buffer with the page as `ue.buffers[Name]`: `{ data: <typed array>, version }`, without copying.
+	 * Write to it on the game thread and call MarkDirty(); pages poll `version` to pick up changes.
+	 * Stays published across reloads and freezes; republishing a name replaces the previous buffer.
+	 */
+	void PublishBuffer(const FString& Name, const FULUEJSBufferRef& Buffer);
+	void UnpublishBuffer(const FString& Name);
+
+	/**
+	 * Makes Callback callable from the page as `ue.<Name>(...)`, now and after every reload. It runs on the game
+	 * thread; JS arguments arrive as FULUEJSValue (objects and arrays as JSON strings) and the result is returned to
+	 * the page. Rebinding a name replaces the function; "buffers" is reserved.
+	 */
+	void BindFunction(const FString& Name, FULUEJSCallback Callback);
+
+	/** Typed variant, e.g. `BindFunction(TEXT("buyItem"), TFunction<bool(FName, int32)>(...))`; arguments are converted per parameter. */
+	template<typename RetType, typename... ArgTypes>
+	void BindFunction(const FString& Name, TFunction<RetType(ArgTypes...)> Function)
+	{
+		BindFunction(Name, ultralightue::MakeJSCallback(MoveTemp(Function)));
+	}
+
+	void UnbindFunction(const FString& Name);
+
+	/**
+	 * Queues a call to a page function, e.g. `EnqueueCall(TEXT("hud.setHealth"), Health, MaxHealth)`.
+	 * Queued calls run in order at the start of the next Ultralight tick, under one JS context lock and without
+	 * building or parsing any script. They wait while the page is loading; a frozen view is thawed first.
+	 * Each function is resolved once per page load and called through a cached handle afterwards.
+	 */
+	void EnqueueCall(const FString& Function, TArray<FULUEJSValue> Args);
+
+	template<typename... ArgTypes>
+	void EnqueueCall(const FString& Function, ArgTypes&&... Args)
+	{
+		EnqueueCall(Function, TArray<FULUEJSValue>{ FULUEJSValue(Forward<ArgTypes>(Args))... });
+	}
+
 	// Input helpers
 	UFUNCTION(BlueprintCallable, Category = "Ultralight|Input", meta = (DisplayName = "Inject Mouse Move"))
 	void InjectMouseMove(const FVector2D& Position);
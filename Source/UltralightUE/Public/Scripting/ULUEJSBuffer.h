@@ -0,0 +1,68 @@
+/*
+ * UE-owned memory shared with a page as a JavaScript typed array.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** Element type of a typed array exposed to JavaScript. */
+enum class EULUETypedArrayType : uint8
+{
+	Int8,
+	Uint8,
+	Uint8Clamped,
+	Int16,
+	Uint16,
+	Int32,
+	Uint32,
+	Float32,
+	Float64
+};
+
+/**
+ * Fixed-size block of memory that a page sees as a typed array, without serialization or copies.
+ * The page reads the same bytes UE writes, so write on the game thread (JS runs there during the Ultralight
+ * tick) and call MarkDirty() afterwards; the page sees the new version at the start of the next tick.
+ * The memory lives as long as UE or any page still references it. To resize, publish a new buffer.
+ */
+class ULTRALIGHTUE_API FULUEJSBuffer
+{
+public:
+	static TSharedRef<FULUEJSBuffer, ESPMode::ThreadSafe> Create(EULUETypedArrayType InType, int32 InNumElements);
+	~FULUEJSBuffer();
+
+	FULUEJSBuffer(const FULUEJSBuffer&) = delete;
+	FULUEJSBuffer& operator=(const FULUEJSBuffer&) = delete;
+
+	/** Typed view of the contents; sizeof(T) must match the element type. */
+	template<typename T>
+	TArrayView<T> GetView()
+	{
+		check(sizeof(T) == GetElementSize(Type));
+		return TArrayView<T>(reinterpret_cast<T*>(Data), NumElements);
+	}
+
+	uint8* GetData() { return Data; }
+	int64 GetNumBytes() const { return static_cast<int64>(NumElements) * GetElementSize(Type); }
+	int32 Num() const { return NumElements; }
+	EULUETypedArrayType GetType() const { return Type; }
+
+	/** Bumps the version pages see as `ue.buffers[name].version`. */
+	void MarkDirty() { Version.fetch_add(1, std::memory_order_release); }
+	uint32 GetVersion() const { return Version.load(std::memory_order_acquire); }
+
+	static int32 GetElementSize(EULUETypedArrayType InType);
+
+private:
+	FULUEJSBuffer(EULUETypedArrayType InType, int32 InNumElements);
+
+	uint8* Data = nullptr;
+	int32 NumElements = 0;
+	EULUETypedArrayType Type;
+	std::atomic<uint32> Version{ 1 };
+};
+
+using FULUEJSBufferRef = TSharedRef<FULUEJSBuffer, ESPMode::ThreadSafe>;
+using FULUEJSBufferPtr = TSharedPtr<FULUEJSBuffer, ESPMode::ThreadSafe>;
@@ -0,0 +1,134 @@
+/*
+ * Plain values passed between UE and page script.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/IntegerSequence.h"
+#include <type_traits>
+
+/** Kind of value held by FULUEJSValue. */
+enum class EULUEJSValueType : uint8
+{
+	Undefined,
+	Null,
+	Boolean,
+	Number,
+	String
+};
+
+/**
+ * A JavaScript primitive held on the UE side: undefined, null, boolean, number or string.
+ * Converts implicitly from the matching C++ types so calls read naturally, e.g.
+ * `View->EnqueueCall(TEXT("hud.setHealth"), Health, MaxHealth, TEXT("critical"))`.
+ */
+class ULTRALIGHTUE_API FULUEJSValue
+{
+public:
+	FULUEJSValue() = default;
+	FULUEJSValue(bool bInValue) : Type(EULUEJSValueType::Boolean), Number(bInValue ? 1.0 : 0.0) {}
+	FULUEJSValue(int32 InValue) : Type(EULUEJSValueType::Number), Number(InValue) {}
+	FULUEJSValue(uint32 InValue) : Type(EULUEJSValueType::Number), Number(InValue) {}
+	FULUEJSValue(int64 InValue) : Type(EULUEJSValueType::Number), Number(static_cast<double>(InValue)) {}
+	FULUEJSValue(float InValue) : Type(EULUEJSValueType::Number), Number(InValue) {}
+	FULUEJSValue(double InValue) : Type(EULUEJSValueType::Number), Number(InValue) {}
+	FULUEJSValue(TYPE_OF_NULLPTR) : Type(EULUEJSValueType::Null) {}
+	FULUEJSValue(const TCHAR* InValue) : Type(EULUEJSValueType::String), String(InValue) {}
+	/** Narrow strings are taken as UTF-8. */
+	FULUEJSValue(const ANSICHAR* InValue) : Type(EULUEJSValueType::String), String(UTF8_TO_TCHAR(InValue)) {}
+	FULUEJSValue(const FString& InValue) : Type(EULUEJSValueType::String), String(InValue) {}
+	FULUEJSValue(FString&& InValue) : Type(EULUEJSValueType::String), String(MoveTemp(InValue)) {}
+	FULUEJSValue(const FName& InValue) : Type(EULUEJSValueType::String), String(InValue.ToString()) {}
+	FULUEJSValue(const FText& InValue) : Type(EULUEJSValueType::String), String(InValue.ToString()) {}
+	/** Any other pointer would otherwise convert to bool and reach the page as true. */
+	template<typename T>
+	FULUEJSValue(const T*) = delete;
+
+	static FULUEJSValue MakeNull()
+	{
+		FULUEJSValue Value;
+		Value.Type = EULUEJSValueType::Null;
+		return Value;
+	}
+
+	EULUEJSValueType GetType() const { return Type; }
+	bool IsUndefined() const { return Type == EULUEJSValueType::Undefined; }
+	bool IsNull() const { return Type == EULUEJSValueType::Null; }
+
+	/** Conversions follow JavaScript's loosely: numbers are truthy when non-zero, strings when non-empty. */
+	bool AsBool() const { return Type == EULUEJSValueType::String ? !String.IsEmpty() : Number != 0.0; }
+	/** Strings are parsed; anything else that isn't a number or boolean is 0. */
+	double AsNumber() const { return Type == EULUEJSValueType::String ? FCString::Atod(*String) : Number; }
+	/** The string held; empty for every other type. */
+	const FString& AsString() const { return String; }
+	/** Any type as text, the way JavaScript's String() would print it. */
+	FString ToString() const;
+
+	/** Converts to a parameter type of a bound native function (see ultralightue::MakeJSCallback). */
+	template<typename T>
+	T As() const;
+
+private:
+	EULUEJSValueType Type = EULUEJSValueType::Undefined;
+	double Number = 0.0;
+	FString String;
+};
+
+template<> inline FULUEJSValue FULUEJSValue::As<FULUEJSValue>() const { return *this; }
+template<> inline bool FULUEJSValue::As<bool>() const { return AsBool(); }
+template<> inline double FULUEJSValue::As<double>() const { return AsNumber(); }
+template<> inline float FULUEJSValue::As<float>() const { return static_cast<float>(AsNumber()); }
+template<> inline int32 FULUEJSValue::As<int32>() const { return FMath::IsFinite(AsNumber()) ? static_cast<int32>(FMath::Clamp<double>(AsNumber(), MIN_int32, MAX_int32)) : 0; }
+template<> inline uint32 FULUEJSValue::As<uint32>() const { return FMath::IsFinite(AsNumber()) ? static_cast<uint32>(FMath::Clamp<double>(AsNumber(), 0, MAX_uint32)) : 0; }
+// MAX_int64 rounds up to 2^63 as a double, which doesn't fit; clamp to the largest double below it instead.
+template<> inline int64 FULUEJSValue::As<int64>() const { return FMath::IsFinite(AsNumber()) ? static_cast<int64>(FMath::Clamp<double>(AsNumber(), MIN_int64, 9223372036854774784.0)) : 0; }
+template<> inline FString FULUEJSValue::As<FString>() const { return ToString(); }
+template<> inline FName FULUEJSValue::As<FName>() const { return FName(*ToString()); }
+template<> inline FText FULUEJSValue::As<FText>() const { return FText::FromString(ToString()); }
+
+/**
+ * Native function callable from page script. Arguments arrive as FULUEJSValue (objects and arrays as JSON strings);
+ * the return value is handed back to the caller.
+ */
+using FULUEJSCallback = TFunction<FULUEJSValue(TConstArrayView<FULUEJSValue>)>;
+
+namespace ultralightue
+{
+	namespace JSCallbackPrivate
+	{
+		template<typename T>
+		typename TDecay<T>::Type GetArg(TConstArrayView<FULUEJSValue> Args, int32 Index)
+		{
+			// Missing arguments are undefined, as in JavaScript.
+			return (Args.IsValidIndex(Index) ? Args[Index] : FULUEJSValue()).template As<typename TDecay<T>::Type>();
+		}
+
+		template<typename RetType, typename... ArgTypes, int32... Indices>
+		FULUEJSValue Invoke(const TFunction<RetType(ArgTypes...)>& Function, TConstArrayView<FULUEJSValue> Args, TIntegerSequence<int32, Indices...>)
+		{
+			if constexpr (std::is_void_v<RetType>)
+			{
+				Function(GetArg<ArgTypes>(Args, Indices)...);
+				return FULUEJSValue();
+			}
+			else
+			{
+				return FULUEJSValue(Function(GetArg<ArgTypes>(Args, Indices)...));
+			}
+		}
+	}
+
+	/**
+	 * Wraps a typed native function as a FULUEJSCallback: each JS argument is converted to the matching parameter type
+	 * (bool, integers, float, double, FString, FName, FText or FULUEJSValue) and the result back to a JS value.
+	 */
+	template<typename RetType, typename... ArgTypes>
+	FULUEJSCallback MakeJSCallback(TFunction<RetType(ArgTypes...)> Function)
+	{
+		return [Function = MoveTemp(Function)](TConstArrayView<FULUEJSValue> Args)
+		{
+			return JSCallbackPrivate::Invoke(Function, Args, TMakeIntegerSequence<int32, sizeof...(ArgTypes)>());
+		};
+	}
+}
@@ -26,8 +26,8 @@
 #include "CoreMinimal.h"
 #include "Templates/UniquePtr.h"
 
-// Forward declare log category (defined in ULUEILoggerInterface.cpp)
-DECLARE_LOG_CATEGORY_EXTERN(LogUltralightUE, Log, All);
+// Log category (defined in the UltralightUEShaders module so both modules share it)
+#include "ULUELog.h"
 
 namespace ultralightue
 {
@@ -1,12 +1,13 @@
 /*
- * Game instance subsystem that owns the Ultralight renderer and ticks it.
+ * Game instance subsystem that creates Ultralight views.
+ * All game instances (including every PIE client) share one renderer; each gets its own session.
  */
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
-#include "Containers/Ticker.h"
+#include "Rendering/ULUEView.h"
 #include "ULUESubsystem.generated.h"
 
 class UUltralightView;
@@ -21,21 +22,47 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
-	/** Create a view and optionally supply an existing RenderTarget. */
+	/**
+	 * Create a view and optionally supply an existing RenderTarget. Accelerated views render on the GPU through RDG.
+	 * SessionName picks a named session (see CreateSession; unknown names are created in memory);
+	 * empty uses this game instance's own session.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Ultralight", meta = (DisplayName = "Create Ultralight View"))
-	UUltralightView* CreateView(int32 Width, int32 Height, bool bTransparent, const FString& InitialURL = TEXT(""), UTextureRenderTarget2D* ExistingTarget = nullptr);
+	UUltralightView* CreateView(int32 Width, int32 Height, bool bTransparent, const FString& InitialURL = TEXT(""), UTextureRenderTarget2D* ExistingTarget = nullptr, bool bAccelerated = false, const FString& SessionName = TEXT(""));
 
 	UFUNCTION(BlueprintCallable, Category = "Ultralight", meta = (DisplayName = "Destroy Ultralight View"))
 	void DestroyView(UUltralightView* View);
 
+	/**
+	 * Create (or find) a named session shared by all game instances. Persistent sessions keep cookies,
+	 * localStorage and the HTTP/disk cache under Saved/UltralightCache across runs, so pages that are
+	 * revisited (launcher, store) load from the warm cache. Name must be a valid file name.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultralight|Session", meta = (DisplayName = "Create Ultralight Session"))
+	bool CreateSession(const FString& Name, bool bPersistent = true);
+
+	UFUNCTION(BlueprintPure, Category = "Ultralight|Session", meta = (DisplayName = "Has Ultralight Session"))
+	bool HasSession(const FString& Name) const;
+
+	/** On-disk location of a persistent session, or empty for in-memory and unknown sessions. */
+	UFUNCTION(BlueprintPure, Category = "Ultralight|Session", meta = (DisplayName = "Get Ultralight Session Disk Path"))
+	FString GetSessionDiskPath(const FString& Name) const;
+
+	/** Last-frame timings of this game instance's live views, keyed by debug name or URL (see FULUEViewTimings::Name). */
+	UFUNCTION(BlueprintCallable, Category = "Ultralight|Stats", meta = (DisplayName = "Get Ultralight View Timings"))
+	TArray<FULUEViewTimings> GetViewTimings() const;
+
 	UFUNCTION(BlueprintPure, Category = "Ultralight", meta = (DisplayName = "Get Ultralight Resource Root"))
 	FString GetResourceRoot() const { return ResourceRoot; }
 
 private:
 	bool EnsureRenderer();
-	bool Tick(float DeltaSeconds);
 
+	/// Reference on the shared renderer (FULUERenderer::Acquire/Release).
 	TSharedPtr<FULUERenderer> Renderer;
+	/// This game instance's cookies, storage and cache; the default for its views.
+	ultralight::RefPtr<ultralight::Session> Session;
+	/// Views created here, whatever their session; torn down with the game instance.
+	TArray<TWeakObjectPtr<UUltralightView>> CreatedViews;
 	FString ResourceRoot;
-	FTSTicker::FDelegateHandle TickHandle;
 };
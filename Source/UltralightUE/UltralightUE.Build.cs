@@ -56,6 +56,7 @@ public class UltralightUE : ModuleRules
                 "Slate",
                 "SlateCore",
                 "UltralightUELibrary",
+                "UltralightUEShaders",
                 "PakFile",
                 "RSA"
             }
@@ -68,6 +69,12 @@ public class UltralightUE : ModuleRules
 			}
             );
 
+        if (Target.bBuildEditor)
+        {
+            // UI hot reload (ULUEHotReload) watches uicontent while iterating in the editor.
+            PrivateDependencyModuleNames.Add("DirectoryWatcher");
+        }
+
         DynamicallyLoadedModuleNames.AddRange(
             new string[]
             {
@@ -0,0 +1,160 @@
+/*
+ * Global shader registration, vertex layouts and PSO helpers for the Ultralight shader programs.
+ */
+
+#include "ULUEShaders.h"
+#include "ULUELog.h"
+#include "PipelineStateCache.h"
+#include "RHIStaticStates.h"
+#include "GlobalShader.h"
+
+IMPLEMENT_GLOBAL_SHADER(FULUEFillVS, "/Plugin/UltralightUE/Private/ULUEFill.usf", "MainVS", SF_Vertex);
+IMPLEMENT_GLOBAL_SHADER(FULUEFillPS, "/Plugin/UltralightUE/Private/ULUEFill.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FULUEFillPathVS, "/Plugin/UltralightUE/Private/ULUEFillPath.usf", "MainVS", SF_Vertex);
+IMPLEMENT_GLOBAL_SHADER(FULUEFillPathPS, "/Plugin/UltralightUE/Private/ULUEFillPath.usf", "MainPS", SF_Pixel);
+
+TGlobalResource<FULUEFillVertexDeclaration> GULUEFillVertexDeclaration;
+TGlobalResource<FULUEFillPathVertexDeclaration> GULUEFillPathVertexDeclaration;
+
+/* -------------------------------------------------------------------------- */
+/*                            Vertex declarations                             */
+/* -------------------------------------------------------------------------- */
+
+void FULUEFillVertexDeclaration::InitRHI(FRHICommandListBase& RHICmdList)
+{
+	// ultralight::Vertex_2f_4ub_2f_2f_28f, 140 bytes, tightly packed.
+	constexpr uint16 Stride = 140;
+
+	FVertexDeclarationElementList Elements;
+	Elements.Add(FVertexElement(0, 0, VET_Float2, 0, Stride));    // pos
+	Elements.Add(FVertexElement(0, 8, VET_UByte4N, 1, Stride));   // color
+	Elements.Add(FVertexElement(0, 12, VET_Float2, 2, Stride));   // tex
+	Elements.Add(FVertexElement(0, 20, VET_Float2, 3, Stride));   // obj
+	for (uint8 DataIndex = 0; DataIndex < 7; ++DataIndex)
+	{
+		Elements.Add(FVertexElement(0, 28 + DataIndex * 16, VET_Float4, 4 + DataIndex, Stride)); // data0..data6
+	}
+
+	VertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(Elements);
+}
+
+void FULUEFillVertexDeclaration::ReleaseRHI()
+{
+	VertexDeclarationRHI.SafeRelease();
+}
+
+void FULUEFillPathVertexDeclaration::InitRHI(FRHICommandListBase& RHICmdList)
+{
+	// ultralight::Vertex_2f_4ub_2f, 20 bytes, tightly packed.
+	constexpr uint16 Stride = 20;
+
+	FVertexDeclarationElementList Elements;
+	Elements.Add(FVertexElement(0, 0, VET_Float2, 0, Stride));    // pos
+	Elements.Add(FVertexElement(0, 8, VET_UByte4N, 1, Stride));   // color
+	Elements.Add(FVertexElement(0, 12, VET_Float2, 2, Stride));   // obj
+
+	VertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(Elements);
+}
+
+void FULUEFillPathVertexDeclaration::ReleaseRHI()
+{
+	VertexDeclarationRHI.SafeRelease();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               PSO helpers                                  */
+/* -------------------------------------------------------------------------- */
+
+namespace ultralightue
+{
+	void SetupGraphicsPipelineState(FGraphicsPipelineStateInitializer& OutInitializer, FGlobalShaderMap* ShaderMap, EULUEShaderProgram Program, bool bEnableBlend)
+	{
+		check(ShaderMap);
+
+		if (Program == EULUEShaderProgram::Fill)
+		{
+			OutInitializer.BoundShaderState.VertexDeclarationRHI = GULUEFillVertexDeclaration.VertexDeclarationRHI;
+			OutInitializer.BoundShaderState.VertexShaderRHI = ShaderMap->GetShader<FULUEFillVS>().GetVertexShader();
+			OutInitializer.BoundShaderState.PixelShaderRHI = ShaderMap->GetShader<FULUEFillPS>().GetPixelShader();
+		}
+		else
+		{
+			OutInitializer.BoundShaderState.VertexDeclarationRHI = GULUEFillPathVertexDeclaration.VertexDeclarationRHI;
+			OutInitializer.BoundShaderState.VertexShaderRHI = ShaderMap->GetShader<FULUEFillPathVS>().GetVertexShader();
+			OutInitializer.BoundShaderState.PixelShaderRHI = ShaderMap->GetShader<FULUEFillPathPS>().GetPixelShader();
+		}
+
+		// Premultiplied alpha, same factors as the SDK's reference D3D11 driver.
+		OutInitializer.BlendState = bEnableBlend
+			? TStaticBlendState<CW_RGBA, BO_Add, BF_One, BF_InverseSourceAlpha, BO_Add, BF_InverseDestAlpha, BF_One>::GetRHI()
+			: TStaticBlendState<>::GetRHI();
+		// Scissor is dynamic state in UE, so it does not add PSO permutations.
+		OutInitializer.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+		OutInitializer.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+		OutInitializer.PrimitiveType = PT_TriangleList;
+
+		OutInitializer.RenderTargetsEnabled = 1;
+		OutInitializer.RenderTargetFormats[0] = UE_PIXELFORMAT_TO_UINT8(ULUERenderBufferFormat);
+		OutInitializer.RenderTargetFlags[0] = TexCreate_RenderTargetable | TexCreate_ShaderResource;
+		OutInitializer.NumSamples = 1;
+
+		OutInitializer.StatePrecachePSOHash = RHIComputeStatePrecachePSOHash(OutInitializer);
+	}
+
+	int32 PrecacheGraphicsPipelineStates(ERHIFeatureLevel::Type FeatureLevel)
+	{
+		check(IsInRenderingThread());
+
+		if (!PipelineStateCache::IsPSOPrecachingEnabled())
+		{
+			return 0;
+		}
+
+		FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(FeatureLevel);
+		if (!ShaderMap || !VerifyShaderPermutations(GShaderPlatformForFeatureLevel[FeatureLevel]))
+		{
+			return 0;
+		}
+
+		int32 NumRequested = 0;
+		for (EULUEShaderProgram Program : { EULUEShaderProgram::Fill, EULUEShaderProgram::FillPath })
+		{
+			for (bool bEnableBlend : { false, true })
+			{
+				FGraphicsPipelineStateInitializer Initializer;
+				SetupGraphicsPipelineState(Initializer, ShaderMap, Program, bEnableBlend);
+				PipelineStateCache::PrecacheGraphicsPipelineState(Initializer);
+				++NumRequested;
+			}
+		}
+
+		UE_LOG(LogUltralightUE, Log, TEXT("Requested %d Ultralight PSO precaches"), NumRequested);
+		return NumRequested;
+	}
+
+	bool VerifyShaderPermutations(EShaderPlatform Platform)
+	{
+		const FString PlatformName = FDataDrivenShaderPlatformInfo::GetName(Platform).ToString();
+		FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(Platform);
+		if (!ShaderMap)
+		{
+			UE_LOG(LogUltralightUE, Error, TEXT("No global shader map for %s"), *PlatformName);
+			return false;
+		}
+
+		bool bAllPresent = true;
+		for (const FShaderType* Type : { static_cast<const FShaderType*>(&FULUEFillVS::GetStaticType()),
+										 static_cast<const FShaderType*>(&FULUEFillPS::GetStaticType()),
+										 static_cast<const FShaderType*>(&FULUEFillPathVS::GetStaticType()),
+										 static_cast<const FShaderType*>(&FULUEFillPathPS::GetStaticType()) })
+		{
+			if (!ShaderMap->HasShader(Type, 0))
+			{
+				UE_LOG(LogUltralightUE, Error, TEXT("Missing Ultralight shader %s for %s"), Type->GetName(), *PlatformName);
+				bAllPresent = false;
+			}
+		}
+
+		return bAllPresent;
+	}
+}
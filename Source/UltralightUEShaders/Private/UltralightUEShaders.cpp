@@ -0,0 +1,105 @@
+/*
+ * Shader module for UltralightUE. Loads at PostConfigInit so the Ultralight global shaders are
+ * part of the global shader map, then precaches their PSOs once the RHI is up.
+ */
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+#include "ShaderCore.h"
+#include "ULUEShaders.h"
+#include "ULUELog.h"
+
+#if WITH_EDITOR
+#include "ShaderCompiler.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#endif
+
+DEFINE_LOG_CATEGORY(LogUltralightUE);
+
+class FUltralightUEShadersModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+		const FString ShaderDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("UltralightUE"))->GetBaseDir(), TEXT("Shaders"));
+		AddShaderSourceDirectoryMapping(TEXT("/Plugin/UltralightUE"), ShaderDir);
+
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FUltralightUEShadersModule::OnPostEngineInit);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	}
+
+private:
+	void OnPostEngineInit()
+	{
+#if WITH_EDITOR
+		if (IsRunningCookCommandlet())
+		{
+			VerifyCookedPlatforms();
+			return;
+		}
+#endif
+
+		if (!FApp::CanEverRender())
+		{
+			return;
+		}
+
+		// Precache every program/blend PSO so the first accelerated view never compiles on demand.
+		ENQUEUE_RENDER_COMMAND(ULUEPrecachePSOs)([](FRHICommandListImmediate&)
+		{
+			ultralightue::PrecacheGraphicsPipelineStates(GMaxRHIFeatureLevel);
+		});
+	}
+
+#if WITH_EDITOR
+	/// Fails the cook if any Ultralight shader is missing for a cooked shader format.
+	void VerifyCookedPlatforms()
+	{
+		TArray<FString> FailedFormats;
+		ITargetPlatformManagerModule& TPM = GetTargetPlatformManagerRef();
+		for (const ITargetPlatform* TargetPlatform : TPM.GetActiveTargetPlatforms())
+		{
+			TArray<FName> ShaderFormats;
+			TargetPlatform->GetAllTargetedShaderFormats(ShaderFormats);
+			for (const FName& ShaderFormat : ShaderFormats)
+			{
+				const EShaderPlatform ShaderPlatform = ShaderFormatToLegacyShaderPlatform(ShaderFormat);
+				if (!IsFeatureLevelSupported(ShaderPlatform, ERHIFeatureLevel::SM5))
+				{
+					continue;
+				}
+
+				// The cooker compiles these maps anyway; this only forces it to happen before we look.
+				CompileGlobalShaderMap(ShaderPlatform, TargetPlatform, false);
+				if (ultralightue::VerifyShaderPermutations(ShaderPlatform))
+				{
+					UE_LOG(LogUltralightUE, Display, TEXT("All Ultralight shader permutations present for %s"), *ShaderFormat.ToString());
+				}
+				else
+				{
+					FailedFormats.Add(ShaderFormat.ToString());
+				}
+			}
+		}
+
+		// Error logs alone don't stop the cooker, and cooking on would ship a build that can't draw accelerated views.
+		if (FailedFormats.Num() > 0)
+		{
+			UE_LOG(LogUltralightUE, Fatal, TEXT("Ultralight shaders missing for %s (see errors above); cook aborted"), *FString::Join(FailedFormats, TEXT(", ")));
+		}
+	}
+#endif
+
+	FDelegateHandle PostEngineInitHandle;
+};
+
+IMPLEMENT_MODULE(FUltralightUEShadersModule, UltralightUEShaders)
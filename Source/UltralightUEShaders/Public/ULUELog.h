@@ -0,0 +1,10 @@
+/*
+ * Log category shared by the UltralightUE modules. Declared here because this module loads first
+ * (PostConfigInit) and UltralightUE already depends on it.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+ULTRALIGHTUESHADERS_API DECLARE_LOG_CATEGORY_EXTERN(LogUltralightUE, Log, All);
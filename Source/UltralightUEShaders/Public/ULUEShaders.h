@@ -0,0 +1,131 @@
+/*
+ * UE global shader ports of the Ultralight SDK shader programs.
+ * Fill (quad geometry) and FillPath (tessellated paths), each a VS/PS pair.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+#include "RenderResource.h"
+#include "RHIResources.h"
+
+/** Mirrors the SDK "Uniforms" cbuffer (see Shaders/Private/ULUECommon.ush). */
+BEGIN_SHADER_PARAMETER_STRUCT(FULUEShaderUniforms, ULTRALIGHTUESHADERS_API)
+	SHADER_PARAMETER(FVector4f, State)
+	SHADER_PARAMETER(FMatrix44f, Transform)
+	SHADER_PARAMETER_ARRAY(FVector4f, Scalar4, [2])
+	SHADER_PARAMETER_ARRAY(FVector4f, Vector, [8])
+	SHADER_PARAMETER(uint32, ClipSize)
+	SHADER_PARAMETER_ARRAY(FMatrix44f, Clip, [8])
+END_SHADER_PARAMETER_STRUCT()
+
+/** Base for all Ultralight shaders; they only need SM5-class features. */
+class ULTRALIGHTUESHADERS_API FULUEGlobalShader : public FGlobalShader
+{
+public:
+	FULUEGlobalShader() = default;
+	FULUEGlobalShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FGlobalShader(Initializer)
+	{
+	}
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+};
+
+/** Vertex shader for Vertex_2f_4ub_2f_2f_28f (SDK: v2f_c4f_t2f_t2f_d28f). */
+class ULTRALIGHTUESHADERS_API FULUEFillVS : public FULUEGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FULUEFillVS);
+	SHADER_USE_PARAMETER_STRUCT(FULUEFillVS, FULUEGlobalShader);
+
+	using FParameters = FULUEShaderUniforms;
+};
+
+/** Pixel shader for quad fills (SDK: fill). */
+class ULTRALIGHTUESHADERS_API FULUEFillPS : public FULUEGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FULUEFillPS);
+	SHADER_USE_PARAMETER_STRUCT(FULUEFillPS, FULUEGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_INCLUDE(FULUEShaderUniforms, Uniforms)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, Texture0)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, Texture1)
+		SHADER_PARAMETER_SAMPLER(SamplerState, Sampler0)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+/** Vertex shader for Vertex_2f_4ub_2f (SDK: v2f_c4f_t2f). */
+class ULTRALIGHTUESHADERS_API FULUEFillPathVS : public FULUEGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FULUEFillPathVS);
+	SHADER_USE_PARAMETER_STRUCT(FULUEFillPathVS, FULUEGlobalShader);
+
+	using FParameters = FULUEShaderUniforms;
+};
+
+/** Pixel shader for tessellated path fills (SDK: fill_path). */
+class ULTRALIGHTUESHADERS_API FULUEFillPathPS : public FULUEGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FULUEFillPathPS);
+	SHADER_USE_PARAMETER_STRUCT(FULUEFillPathPS, FULUEGlobalShader);
+
+	using FParameters = FULUEShaderUniforms;
+};
+
+/** Input layout for ultralight::Vertex_2f_4ub_2f_2f_28f. */
+class ULTRALIGHTUESHADERS_API FULUEFillVertexDeclaration : public FRenderResource
+{
+public:
+	FVertexDeclarationRHIRef VertexDeclarationRHI;
+
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+	virtual void ReleaseRHI() override;
+};
+
+/** Input layout for ultralight::Vertex_2f_4ub_2f. */
+class ULTRALIGHTUESHADERS_API FULUEFillPathVertexDeclaration : public FRenderResource
+{
+public:
+	FVertexDeclarationRHIRef VertexDeclarationRHI;
+
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+	virtual void ReleaseRHI() override;
+};
+
+extern ULTRALIGHTUESHADERS_API TGlobalResource<FULUEFillVertexDeclaration> GULUEFillVertexDeclaration;
+extern ULTRALIGHTUESHADERS_API TGlobalResource<FULUEFillPathVertexDeclaration> GULUEFillPathVertexDeclaration;
+
+namespace ultralightue
+{
+	/// Shader program selector, matches ultralight::ShaderType.
+	enum class EULUEShaderProgram : uint8
+	{
+		Fill,
+		FillPath,
+	};
+
+	/// Render buffer format used for every Ultralight render target.
+	constexpr EPixelFormat ULUERenderBufferFormat = PF_B8G8R8A8;
+
+	/// @brief Fills a graphics PSO initializer for one Ultralight program / blend combination.
+	/// Used both for drawing and for PSO precaching, so the two always agree.
+	ULTRALIGHTUESHADERS_API void SetupGraphicsPipelineState(FGraphicsPipelineStateInitializer& OutInitializer, FGlobalShaderMap* ShaderMap, EULUEShaderProgram Program, bool bEnableBlend);
+
+	/// @brief Requests PSO precompilation for every program / blend combination.
+	/// @return Number of PSOs submitted.
+	ULTRALIGHTUESHADERS_API int32 PrecacheGraphicsPipelineStates(ERHIFeatureLevel::Type FeatureLevel);
+
+	/// @brief Checks that every Ultralight shader permutation exists in the global shader map of a platform.
+	/// @return false (and logs each missing permutation) if any are absent.
+	ULTRALIGHTUESHADERS_API bool VerifyShaderPermutations(EShaderPlatform Platform);
+}
@@ -0,0 +1,69 @@
+/*
+ *   Copyright (c) 2023 Mikael Aboagye & Ultralight Inc.
+ *   All rights reserved.
+
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ 
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ 
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+using UnrealBuildTool;
+
+public class UltralightUEShaders : ModuleRules
+{
+    public UltralightUEShaders(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicIncludePaths.AddRange(
+            new string[] {
+                System.IO.Path.Combine(ModuleDirectory, "Public")
+            }
+        );
+
+        PrivateIncludePaths.AddRange(
+            new string[] {
+                System.IO.Path.Combine(ModuleDirectory, "Private")
+            }
+        );
+
+        // Global shaders have to be registered before the global shader map is compiled, so this module loads
+        // at PostConfigInit. Runtime dependencies stay free of UObject modules; it also declares LogUltralightUE.
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "RenderCore",
+                "RHI",
+                "Projects"
+            }
+        );
+
+        if (Target.bBuildEditor)
+        {
+            // Editor builds link Engine (CompileGlobalShaderMap) and TargetPlatform for the cook-time check, which
+            // runs from OnPostEngineInit once those modules are up and aborts the cook if a shader is missing.
+            PrivateDependencyModuleNames.AddRange(
+                new string[]
+                {
+                    "Engine",
+                    "TargetPlatform"
+                }
+            );
+        }
+    }
+}